@@ -500,6 +500,19 @@ void lcCamera::CopySettings(const lcCamera* camera)
 	mState |= (camera->mState & LC_CAMERA_ORTHO);
 }
 
+/*** LPub3D Mod - native render session ***/
+void lcCamera::CopyCamera(const lcCamera* Camera)
+{
+	CopySettings(Camera);
+	SetOrtho(Camera->IsOrtho());
+
+	mWorldView = Camera->mWorldView;
+	mPosition = Camera->mPosition;
+	mTargetPosition = Camera->mTargetPosition;
+	mUpVector = Camera->mUpVector;
+}
+/*** LPub3D Mod end ***/
+
 void lcCamera::DrawInterface(lcContext* Context, const lcScene& Scene) const
 {
 	Q_UNUSED(Scene);
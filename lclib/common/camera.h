@@ -311,6 +311,9 @@ public:
 	void UpdatePosition(lcStep Step) override;
 	void CopyPosition(const lcCamera* Camera);
 	void CopySettings(const lcCamera* Camera);
+/*** LPub3D Mod - native render session ***/
+	void CopyCamera(const lcCamera* Camera);
+/*** LPub3D Mod end ***/
 
 	void ZoomExtents(float AspectRatio, const lcVector3& Center, const std::vector<lcVector3>& Points, lcStep Step, bool AddKey);
 	void ZoomRegion(float AspectRatio, const lcVector3& Position, const lcVector3& TargetPosition, const lcVector3* Corners, lcStep Step, bool AddKey);
@@ -7,23 +7,93 @@ static void CopyFromQImage(const QImage& Src, Image& Dest)
 	const bool Alpha = Src.hasAlphaChannel();
 	Dest.Allocate(Src.width(), Src.height(), Alpha ? lcPixelFormat::R8G8B8A8 : lcPixelFormat::R8G8B8);
 
-	quint8* Bytes = (quint8*)Dest.mData;
+/*** LPub3D Mod - texture load pipeline ***/
+	// both formats hold unpremultiplied bytes in R, G, B(, A) order, so rows copy as they are
+	const QImage Converted = Src.convertToFormat(Alpha ? QImage::Format_RGBA8888 : QImage::Format_RGB888);
+	const int RowSize = Dest.mWidth * Dest.GetBPP();
 
 	for (int y = 0; y < Dest.mHeight; y++)
+		memcpy(Dest.mData + y * RowSize, Converted.constScanLine(y), RowSize);
+/*** LPub3D Mod end ***/
+}
+
+/*** LPub3D Mod - filtered resize ***/
+struct lcResizeFilter
+{
+	int Taps;
+	std::vector<int> Indices;
+	std::vector<int> Weights;
+};
+
+#define LC_RESIZE_WEIGHT_SHIFT 14
+
+// Per destination pixel source indices and fixed point weights, a box filter when shrinking and bilinear otherwise.
+static lcResizeFilter lcGetResizeFilter(int SrcSize, int DstSize)
+{
+	lcResizeFilter Filter;
+	const double Scale = (double)SrcSize / (double)DstSize;
+	const bool Shrink = SrcSize > DstSize;
+
+	Filter.Taps = Shrink ? (int)ceil(Scale) + 1 : 2;
+	Filter.Indices.resize(DstSize * Filter.Taps, 0);
+	Filter.Weights.resize(DstSize * Filter.Taps, 0);
+
+	for (int Dst = 0; Dst < DstSize; Dst++)
 	{
-		for (int x = 0; x < Dest.mWidth; x++)
+		int* Indices = &Filter.Indices[Dst * Filter.Taps];
+		int* Weights = &Filter.Weights[Dst * Filter.Taps];
+		double TapWeights[2];
+		int First, Count;
+
+		if (Shrink)
+		{
+			const double Begin = Dst * Scale;
+			const double End = (Dst + 1) * Scale;
+
+			First = (int)floor(Begin);
+			Count = qMin((int)ceil(End), SrcSize) - First;
+
+			for (int Tap = 0; Tap < Count; Tap++)
+				Indices[Tap] = First + Tap;
+		}
+		else
 		{
-			QRgb Pixel = Src.pixel(x, y);
+			const double Center = (Dst + 0.5) * Scale - 0.5;
+			First = (int)floor(Center);
+			Count = 2;
 
-			*Bytes++ = qRed(Pixel);
-			*Bytes++ = qGreen(Pixel);
-			*Bytes++ = qBlue(Pixel);
+			TapWeights[1] = Center - First;
+			TapWeights[0] = 1.0 - TapWeights[1];
 
-			if (Alpha)
-				*Bytes++ = qAlpha(Pixel);
+			Indices[0] = qBound(0, First, SrcSize - 1);
+			Indices[1] = qBound(0, First + 1, SrcSize - 1);
 		}
+
+		int Sum = 0;
+
+		for (int Tap = 0; Tap < Count; Tap++)
+		{
+			double Weight;
+
+			if (Shrink)
+			{
+				const double Begin = qMax(Dst * Scale, (double)(First + Tap));
+				const double End = qMin((Dst + 1) * Scale, (double)(First + Tap + 1));
+				Weight = (End - Begin) / Scale;
+			}
+			else
+				Weight = TapWeights[Tap];
+
+			Weights[Tap] = (int)(Weight * (1 << LC_RESIZE_WEIGHT_SHIFT) + 0.5);
+			Sum += Weights[Tap];
+		}
+
+		Weights[0] += (1 << LC_RESIZE_WEIGHT_SHIFT) - Sum;
 	}
+
+	return Filter;
 }
+/*** LPub3D Mod end ***/
 
 Image::Image()
 {
@@ -126,43 +196,81 @@ void Image::ResizePow2()
 		Resize (shifted_x, shifted_y);
 }
 
-void Image::Resize(int width, int height)
+/*** LPub3D Mod - filtered resize ***/
+// Separable resize, rows first. The column pass runs over whole rows so the compiler can vectorize it.
+void Image::Resize(int Width, int Height)
 {
-	int i, j, k, components, stx, sty;
-	float accumx, accumy;
-	unsigned char* bits = nullptr;
-
-	components = GetBPP();
-	const int BufferSize = width * height * components;
+	const int Components = GetBPP();
+	const int BufferSize = Width * Height * Components;
+	unsigned char* Bits = nullptr;
 
-	if (BufferSize)
+	if (BufferSize && mData && mWidth && mHeight)
 	{
-		bits = (unsigned char*)malloc(BufferSize);
+		Bits = (unsigned char*)malloc(BufferSize);
 
-		if (bits)
+		if (Bits)
 		{
-			for (j = 0; j < mHeight; j++)
+			const lcResizeFilter FilterX = lcGetResizeFilter(mWidth, Width);
+			const lcResizeFilter FilterY = lcGetResizeFilter(mHeight, Height);
+			const int RowSize = Width * Components;
+			std::vector<unsigned char> Rows(RowSize * mHeight);
+			std::vector<int> Accum(RowSize);
+
+			for (int y = 0; y < mHeight; y++)
 			{
-				accumy = (float)height*j / (float)mHeight;
-				sty = (int)floor(accumy);
+				const unsigned char* Src = mData + y * mWidth * Components;
+				unsigned char* Dst = Rows.data() + y * RowSize;
 
-				for (i = 0; i < mWidth; i++)
+				for (int x = 0; x < Width; x++)
 				{
-					accumx = (float)width*i / (float)mWidth;
-					stx = (int)floor(accumx);
+					const int* Indices = &FilterX.Indices[x * FilterX.Taps];
+					const int* Weights = &FilterX.Weights[x * FilterX.Taps];
 
-					for (k = 0; k < components; k++)
-						bits[(stx + sty*width)*components + k] = mData[(i + j * mWidth) * components + k];
+					for (int k = 0; k < Components; k++)
+					{
+						int Sum = 0;
+
+						for (int Tap = 0; Tap < FilterX.Taps; Tap++)
+							Sum += Src[Indices[Tap] * Components + k] * Weights[Tap];
+
+						*Dst++ = (unsigned char)((Sum + (1 << (LC_RESIZE_WEIGHT_SHIFT - 1))) >> LC_RESIZE_WEIGHT_SHIFT);
+					}
 				}
 			}
+
+			for (int y = 0; y < Height; y++)
+			{
+				const int* Indices = &FilterY.Indices[y * FilterY.Taps];
+				const int* Weights = &FilterY.Weights[y * FilterY.Taps];
+				unsigned char* Dst = Bits + y * RowSize;
+
+				std::fill(Accum.begin(), Accum.end(), 1 << (LC_RESIZE_WEIGHT_SHIFT - 1));
+
+				for (int Tap = 0; Tap < FilterY.Taps; Tap++)
+				{
+					const int Weight = Weights[Tap];
+
+					if (!Weight)
+						continue;
+
+					const unsigned char* Src = Rows.data() + Indices[Tap] * RowSize;
+
+					for (int i = 0; i < RowSize; i++)
+						Accum[i] += Src[i] * Weight;
+				}
+
+				for (int i = 0; i < RowSize; i++)
+					Dst[i] = (unsigned char)(Accum[i] >> LC_RESIZE_WEIGHT_SHIFT);
+			}
 		}
 	}
 
 	free(mData);
-	mData = bits;
-	mWidth = width;
-	mHeight = height;
+	mData = Bits;
+	mWidth = Width;
+	mHeight = Height;
 }
+/*** LPub3D Mod end ***/
 
 bool Image::FileLoad(lcMemFile& File)
 {
@@ -179,6 +287,20 @@ bool Image::FileLoad(lcMemFile& File)
 	return true;
 }
 
+/*** LPub3D Mod - texture load pipeline ***/
+bool Image::FileLoad(const QByteArray& Data)
+{
+	QImage Image;
+
+	if (!Image.loadFromData(Data))
+		return false;
+
+	CopyFromQImage(Image, *this);
+
+	return true;
+}
+/*** LPub3D Mod end ***/
+
 bool Image::FileLoad(const QString& FileName)
 {
 	QImage Image;
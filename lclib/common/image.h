@@ -29,6 +29,9 @@ public:
 
 	bool FileLoad(lcMemFile& File);
 	bool FileLoad(const QString& FileName);
+/*** LPub3D Mod - texture load pipeline ***/
+	bool FileLoad(const QByteArray& Data);
+/*** LPub3D Mod end ***/
 
 	void Resize(int Width, int Height);
 	void ResizePow2();
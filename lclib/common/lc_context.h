@@ -119,6 +119,12 @@ public:
 	static bool InitializeRenderer();
 	static void ShutdownRenderer();
 	static lcContext* GetGlobalOffscreenContext();
+/*** LPub3D Mod - native software renderer ***/
+	static bool HasOffscreenContext()
+	{
+		return mOffscreenContext != nullptr;
+	}
+/*** LPub3D Mod end ***/
 
 	void CreateResources();
 	void DestroyResources();
@@ -1289,6 +1289,39 @@ void lcPiecesLibrary::ReleasePieceInfo(PieceInfo* Info)
 		Info->Unload();
 }
 
+/*** LPub3D Mod - thumbnail cache ***/
+// Identifies the revision of a part file: the CRC of an archived part, or the size and time of a loose part.
+QByteArray lcPiecesLibrary::GetPieceFileStamp(const PieceInfo* Info) const
+{
+	if (!Info || Info->IsTemporary())
+		return QByteArray();
+
+	if (Info->mZipFileType != lcZipFileType::Count && mZipFiles[static_cast<int>(Info->mZipFileType)])
+	{
+		const std::vector<lcZipFileInfo>& Files = mZipFiles[static_cast<int>(Info->mZipFileType)]->mFiles;
+
+		if (Info->mZipFileIndex < 0 || Info->mZipFileIndex >= static_cast<int>(Files.size()))
+			return QByteArray();
+
+		const lcZipFileInfo& FileInfo = Files[Info->mZipFileIndex];
+
+		return QByteArray::number(FileInfo.crc, 16) + ':' + QByteArray::number(FileInfo.uncompressed_size);
+	}
+
+	const char* Folders[] = { mPreferOfficialParts ? "parts" : "unofficial/parts", mPreferOfficialParts ? "unofficial/parts" : "parts" };
+
+	for (const char* Folder : Folders)
+	{
+		const QFileInfo FileInfo(mLibraryDir.absoluteFilePath(QString("%1/%2").arg(QLatin1String(Folder), QLatin1String(Info->mFileName))));
+
+		if (FileInfo.exists())
+			return QByteArray::number(FileInfo.size()) + ':' + QByteArray::number(FileInfo.lastModified().toMSecsSinceEpoch());
+	}
+
+	return QByteArray();
+}
+/*** LPub3D Mod end ***/
+
 void lcPiecesLibrary::LoadQueuedPiece()
 {
 	mLoadMutex.lock();
@@ -1551,6 +1584,11 @@ void lcPiecesLibrary::ReleaseBuffers()
 {
 	lcContext* Context = lcContext::GetGlobalOffscreenContext();
 
+/*** LPub3D Mod - native software renderer ***/
+	if (!Context)
+		return;
+/*** LPub3D Mod end ***/
+
 	Context->MakeCurrent();
 	Context->DestroyVertexBuffer(mVertexBuffer);
 	Context->DestroyIndexBuffer(mIndexBuffer);
@@ -1630,12 +1668,15 @@ void lcPiecesLibrary::UnloadUnusedParts()
 
 bool lcPiecesLibrary::LoadTexture(lcTexture* Texture)
 {
-	QMutexLocker Lock(&mTextureMutex);
 	char FileName[2*LC_MAXPATH];
 
 	if (mZipFiles[static_cast<int>(lcZipFileType::Official)])
 	{
 		lcMemFile TextureFile;
+/*** LPub3D Mod - texture load pipeline ***/
+		// only the extraction is serialized, textures decode in parallel
+		QMutexLocker Lock(&mTextureMutex);
+/*** LPub3D Mod end ***/
 
 /*** LPub3D Mod - parts load order ***/
 		lcZipFileType ZipFileType = mPreferOfficialParts ? lcZipFileType::Official : lcZipFileType::Unofficial;
@@ -1653,6 +1694,10 @@ bool lcPiecesLibrary::LoadTexture(lcTexture* Texture)
 		}
 /*** LPub3D Mod ***/
 
+/*** LPub3D Mod - texture load pipeline ***/
+		Lock.unlock();
+/*** LPub3D Mod end ***/
+
 		return Texture->Load(TextureFile);
 	}
 	else
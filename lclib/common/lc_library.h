@@ -193,6 +193,15 @@ public:
 		return mStudStyle;
 	}
 
+/*** LPub3D Mod - thumbnail cache ***/
+	bool IsStudCylinderColorEnabled() const
+	{
+		return mStudCylinderColorEnabled;
+	}
+
+	QByteArray GetPieceFileStamp(const PieceInfo* Info) const;
+/*** LPub3D Mod end ***/
+
 	void SetOfficialPieces()
 	{
 		if (mZipFiles[static_cast<int>(lcZipFileType::Official)])
@@ -585,6 +585,149 @@ int lcModel::SplitMPD(QIODevice& Device)
 	return ModelPos;
 }
 
+/*** LPub3D Mod - fast line parser ***/
+static inline bool lcIsLDrawSpace(char c)
+{
+	return c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '\v' || c == '\f';
+}
+
+static inline bool lcIsLDrawDigit(char c)
+{
+	return c >= '0' && c <= '9';
+}
+
+static bool lcParseLDrawInt(const char*& Pos, const char* End, int& Value)
+{
+	while (Pos < End && lcIsLDrawSpace(*Pos))
+		Pos++;
+
+	const char* Src = Pos;
+	const bool Negative = Src < End && *Src == '-';
+
+	if (Negative)
+		Src++;
+
+	// Hexadecimal direct colors and other forms are left to QTextStream
+	if (Src == End || !lcIsLDrawDigit(*Src) || (*Src == '0' && Src + 1 < End && (Src[1] == 'x' || Src[1] == 'X')))
+		return false;
+
+	qint64 Result = 0;
+
+	while (Src < End && lcIsLDrawDigit(*Src))
+	{
+		Result = Result * 10 + (*Src++ - '0');
+
+		if (Result > 0x7fffffff)
+			return false;
+	}
+
+	if (Src < End && !lcIsLDrawSpace(*Src))
+		return false;
+
+	Value = Negative ? -int(Result) : int(Result);
+	Pos = Src;
+
+	return true;
+}
+
+// Plain decimal numbers with up to 19 significant digits and a small exponent are converted exactly,
+// anything else returns false so the caller can use QTextStream instead.
+static bool lcParseLDrawFloat(const char*& Pos, const char* End, float& Value)
+{
+	static const double Powers[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+
+	while (Pos < End && lcIsLDrawSpace(*Pos))
+		Pos++;
+
+	const char* Src = Pos;
+	const bool Negative = Src < End && *Src == '-';
+
+	if (Negative || (Src < End && *Src == '+'))
+		Src++;
+
+	quint64 Mantissa = 0;
+	int Digits = 0;
+	int Exponent = 0;
+	bool HasDigits = false;
+
+	while (Src < End && lcIsLDrawDigit(*Src))
+	{
+		if (Mantissa || *Src != '0')
+		{
+			if (++Digits > 19)
+				return false;
+			Mantissa = Mantissa * 10 + (*Src - '0');
+		}
+		HasDigits = true;
+		Src++;
+	}
+
+	if (Src < End && *Src == '.')
+	{
+		Src++;
+
+		while (Src < End && lcIsLDrawDigit(*Src))
+		{
+			if (Mantissa || *Src != '0')
+			{
+				if (++Digits > 19)
+					return false;
+				Mantissa = Mantissa * 10 + (*Src - '0');
+			}
+			Exponent--;
+			HasDigits = true;
+			Src++;
+		}
+	}
+
+	if (!HasDigits)
+		return false;
+
+	if (Src < End && (*Src == 'e' || *Src == 'E'))
+	{
+		Src++;
+
+		const bool NegativeExponent = Src < End && *Src == '-';
+
+		if (NegativeExponent || (Src < End && *Src == '+'))
+			Src++;
+
+		if (Src == End || !lcIsLDrawDigit(*Src))
+			return false;
+
+		int ExponentValue = 0;
+
+		while (Src < End && lcIsLDrawDigit(*Src))
+		{
+			ExponentValue = ExponentValue * 10 + (*Src++ - '0');
+
+			if (ExponentValue > 100)
+				return false;
+		}
+
+		Exponent += NegativeExponent ? -ExponentValue : ExponentValue;
+	}
+
+	if (Src < End && !lcIsLDrawSpace(*Src))
+		return false;
+
+	double Result = double(Mantissa);
+
+	if (Mantissa)
+	{
+		if (Mantissa > (quint64(1) << 53) || Exponent < -22 || Exponent > 22)
+			return false;
+
+		Result = Exponent < 0 ? Result / Powers[-Exponent] : Result * Powers[Exponent];
+	}
+
+	Value = float(Negative ? -Result : Result);
+	Pos = Src;
+
+	return true;
+}
+/*** LPub3D Mod end ***/
+
 void lcModel::LoadLDraw(QIODevice& Device, Project* Project)
 {
 	lcPiece* Piece = nullptr;
@@ -639,13 +782,169 @@ void lcModel::LoadLDraw(QIODevice& Device, Project* Project)
 	};
 /*** LPub3D Mod end ***/
 
+/*** LPub3D Mod - fast line parser ***/
+	// Part references are resolved once per part name and load, the QString part ID is shared by all pieces using it
+	struct lcLDrawPartReference
+	{
+		QString PartId;
+		PieceInfo* Info;
+		bool Primitive;
+	};
+
+	QHash<QByteArray, lcLDrawPartReference> PartReferences;
+
+	auto FindPartReference = [&](const char* Data, int Size) -> const lcLDrawPartReference&
+	{
+		QHash<QByteArray, lcLDrawPartReference>::const_iterator ReferenceIt = PartReferences.constFind(QByteArray::fromRawData(Data, Size));
+
+		if (ReferenceIt == PartReferences.constEnd())
+		{
+			lcLDrawPartReference Reference;
+			Reference.PartId = QString::fromUtf8(Data, Size);
+
+			const QByteArray CleanId = Reference.PartId.toLatin1().toUpper().replace('\\', '/');
+
+			Reference.Primitive = Library->IsPrimitive(CleanId.constData());
+			Reference.Info = Reference.Primitive ? nullptr : Library->FindPiece(Reference.PartId.toLatin1().constData(), Project, true, true);
+
+			ReferenceIt = PartReferences.insert(QByteArray(Data, Size), Reference);
+		}
+
+		return ReferenceIt.value();
+	};
+
+	auto AddPartReference = [&](int ColorCode, const float* IncludeMatrix, const lcLDrawPartReference& Reference, const QString& OriginalLine)
+	{
+/*** LPub3D Mod - preview widget ***/
+		if (IsUnofficialPart && ColorCode == LDRAW_MATERIAL_COLOUR)
+			ColorCode = mProperties.mUnoffPartColorCode;
+/*** LPub3D Mod end ***/
+
+		if (Reference.Primitive)
+		{
+			mFileLines.append(OriginalLine);
+			return true;
+		}
+
+		lcMatrix44 IncludeTransform(lcVector4(IncludeMatrix[3], IncludeMatrix[6], IncludeMatrix[9], 0.0f), lcVector4(IncludeMatrix[4], IncludeMatrix[7], IncludeMatrix[10], 0.0f),
+									lcVector4(IncludeMatrix[5], IncludeMatrix[8], IncludeMatrix[11], 0.0f), lcVector4(IncludeMatrix[0], IncludeMatrix[1], IncludeMatrix[2], 1.0f));
+
+		if (!Piece)
+			Piece = new lcPiece(nullptr);
+
+		if (!CurrentGroups.empty())
+			Piece->SetGroup(CurrentGroups[CurrentGroups.size() - 1]);
+
+		const float* Matrix = IncludeTransform;
+		const lcMatrix44 Transform(lcVector4(Matrix[0], Matrix[2], -Matrix[1], 0.0f), lcVector4(Matrix[8], Matrix[10], -Matrix[9], 0.0f),
+								   lcVector4(-Matrix[4], -Matrix[6], Matrix[5], 0.0f), lcVector4(Matrix[12], Matrix[14], -Matrix[13], 1.0f));
+
+/*** LPub3D Mod - Selected Parts ***/
+		LineTypeIndex++;
+		Piece->SetLineTypeIndex(LineTypeIndex);
+/*** LPub3D Mod end ***/
+/*** LPub3D Mod - lpub fade highlight ***/
+		Piece->SetLPubFade(mLPubFade);
+		Piece->SetLPubHighlight(mLPubHighlight);
+/*** LPub3D Mod end ***/
+		Piece->SetFileLine(mFileLines.size());
+		Piece->SetPieceInfo(Reference.Info, Reference.PartId, false);
+		Piece->Initialize(Transform, CurrentStep);
+		Piece->SetColorCode(ColorCode);
+		Piece->VerifyControlPoints(ControlPoints);
+		Piece->SetControlPoints(ControlPoints);
+		ControlPoints.clear();
+
+		if (Piece->mPieceInfo->IsModel() && Piece->mPieceInfo->GetModel()->IncludesModel(this))
+		{
+			delete Piece;
+			Piece = nullptr;
+			return false;
+		}
+
+		AddPiece(Piece);
+		Piece = nullptr;
+
+		return true;
+	};
+
+	// Type 1 lines are tokenized in place, lines the fast parser does not accept go through QTextStream below
+	auto ParsePartReferenceLine = [&](const QByteArray& LineData, bool& Added)
+	{
+		const char* Pos = LineData.constData();
+		const char* End = Pos + LineData.size();
+
+		while (Pos < End && lcIsLDrawSpace(*Pos))
+			Pos++;
+
+		if (End - Pos < 2 || Pos[0] != '1' || !lcIsLDrawSpace(Pos[1]))
+			return false;
+
+		Pos++;
+
+		int ColorCode;
+		float IncludeMatrix[12];
+
+		if (!lcParseLDrawInt(Pos, End, ColorCode))
+			return false;
+
+		for (int TokenIdx = 0; TokenIdx < 12; TokenIdx++)
+			if (!lcParseLDrawFloat(Pos, End, IncludeMatrix[TokenIdx]))
+				return false;
+
+		while (Pos < End && lcIsLDrawSpace(*Pos))
+			Pos++;
+
+		while (End > Pos && lcIsLDrawSpace(End[-1]))
+			End--;
+
+		if (Pos == End)
+			return false;
+
+		const lcLDrawPartReference& Reference = FindPartReference(Pos, int(End - Pos));
+
+		Added = AddPartReference(ColorCode, IncludeMatrix, Reference, Reference.Primitive ? QString::fromUtf8(LineData) : QString());
+
+		return true;
+	};
+
+#ifdef QT_DEBUG_MODE
+	QElapsedTimer LoadTimer;
+	LoadTimer.start();
+	int LineCount = 0;
+	int FastLineCount = 0;
+#endif
+/*** LPub3D Mod end ***/
+
 	bool ReadingHeader = true;
 	bool FirstLine = true;
 
 	while (!Device.atEnd())
 	{
 		const qint64 Pos = Device.pos();
-		QString OriginalLine = Device.readLine();
+/*** LPub3D Mod - fast line parser ***/
+		const QByteArray LineData = Device.readLine();
+		bool Added = false;
+
+#ifdef QT_DEBUG_MODE
+		LineCount++;
+#endif
+
+		if (ParsePartReferenceLine(LineData, Added))
+		{
+#ifdef QT_DEBUG_MODE
+			FastLineCount++;
+#endif
+			ReadingHeader = false;
+
+			if (Added)
+				FirstLine = false;
+
+			continue;
+		}
+
+		QString OriginalLine = QString::fromUtf8(LineData);
+/*** LPub3D Mod end ***/
 		QString Line = OriginalLine.trimmed();
 		QTextStream LineStream(&Line, QIODevice::ReadOnly);
 
@@ -860,69 +1159,22 @@ void lcModel::LoadLDraw(QIODevice& Device, Project* Project)
 			ReadingHeader = false;
 			int ColorCode;
 			LineStream >> ColorCode;
-/*** LPub3D Mod - preview widget ***/
-			if (IsUnofficialPart && ColorCode == LDRAW_MATERIAL_COLOUR)
-				ColorCode = mProperties.mUnoffPartColorCode;
-/*** LPub3D Mod end ***/
 
 			float IncludeMatrix[12];
 			for (int TokenIdx = 0; TokenIdx < 12; TokenIdx++)
 				LineStream >> IncludeMatrix[TokenIdx];
 
-			lcMatrix44 IncludeTransform(lcVector4(IncludeMatrix[3], IncludeMatrix[6], IncludeMatrix[9], 0.0f), lcVector4(IncludeMatrix[4], IncludeMatrix[7], IncludeMatrix[10], 0.0f),
-										lcVector4(IncludeMatrix[5], IncludeMatrix[8], IncludeMatrix[11], 0.0f), lcVector4(IncludeMatrix[0], IncludeMatrix[1], IncludeMatrix[2], 1.0f));
-
 			QString PartId = LineStream.readAll().trimmed();
 
 			if (PartId.isEmpty())
 				continue;
 
-			QByteArray CleanId = PartId.toLatin1().toUpper().replace('\\', '/');
-
-			if (Library->IsPrimitive(CleanId.constData()))
-			{
-				mFileLines.append(OriginalLine);
-			}
-			else
-			{
-				if (!Piece)
-					Piece = new lcPiece(nullptr);
-
-				if (!CurrentGroups.empty())
-					Piece->SetGroup(CurrentGroups[CurrentGroups.size() - 1]);
-
-				PieceInfo* Info = Library->FindPiece(PartId.toLatin1().constData(), Project, true, true);
-
-				const float* Matrix = IncludeTransform;
-				const lcMatrix44 Transform(lcVector4(Matrix[0], Matrix[2], -Matrix[1], 0.0f), lcVector4(Matrix[8], Matrix[10], -Matrix[9], 0.0f),
-										   lcVector4(-Matrix[4], -Matrix[6], Matrix[5], 0.0f), lcVector4(Matrix[12], Matrix[14], -Matrix[13], 1.0f));
+/*** LPub3D Mod - fast line parser ***/
+			const QByteArray PartIdData = PartId.toUtf8();
 
-/*** LPub3D Mod - Selected Parts ***/
-				LineTypeIndex++;
-				Piece->SetLineTypeIndex(LineTypeIndex);
+			if (!AddPartReference(ColorCode, IncludeMatrix, FindPartReference(PartIdData.constData(), PartIdData.size()), OriginalLine))
+				continue;
 /*** LPub3D Mod end ***/
-/*** LPub3D Mod - lpub fade highlight ***/
-				Piece->SetLPubFade(mLPubFade);
-				Piece->SetLPubHighlight(mLPubHighlight);
-/*** LPub3D Mod end ***/
-				Piece->SetFileLine(mFileLines.size());
-				Piece->SetPieceInfo(Info, PartId, false);
-				Piece->Initialize(Transform, CurrentStep);
-				Piece->SetColorCode(ColorCode);
-				Piece->VerifyControlPoints(ControlPoints);
-				Piece->SetControlPoints(ControlPoints);
-				ControlPoints.clear();
-
-				if (Piece->mPieceInfo->IsModel() && Piece->mPieceInfo->GetModel()->IncludesModel(this))
-				{
-					delete Piece;
-					Piece = nullptr;
-					continue;
-				}
-
-				AddPiece(Piece);
-				Piece = nullptr;
-			}
 		}
 		else
 		{
@@ -935,6 +1187,14 @@ void lcModel::LoadLDraw(QIODevice& Device, Project* Project)
 
 	mCurrentStep = CurrentStep;
 	CalculateStep(mCurrentStep);
+
+/*** LPub3D Mod - fast line parser ***/
+#ifdef QT_DEBUG_MODE
+	emit gui->messageSig(LOG_DEBUG, QString("Model %1 parsed %2 lines (%3 part references, %4 part names) in %5 ms.")
+										   .arg(mProperties.mFileName).arg(LineCount).arg(FastLineCount).arg(PartReferences.size()).arg(LoadTimer.elapsed()));
+#endif
+/*** LPub3D Mod end ***/
+
 	Library->WaitForLoadQueue();
 	Library->mBuffersDirty = true;
 	Library->UnloadUnusedParts();
@@ -944,6 +1204,100 @@ void lcModel::LoadLDraw(QIODevice& Device, Project* Project)
 	delete Light;
 }
 
+/*** LPub3D Mod - native render session ***/
+bool lcModel::AppendLDrawPieces(const QStringList& Lines, Project* Project)
+{
+	// Only part references, step boundaries and plain comments can be appended to a resident
+	// model. Anything else may change model state so the caller must fall back to a full load.
+	for (const QString& Line : Lines)
+	{
+		const QString Trimmed = Line.trimmed();
+
+		if (Trimmed.isEmpty() || Trimmed.startsWith(QLatin1String("1 ")) || Trimmed == QLatin1String("0 STEP") || Trimmed.startsWith(QLatin1String("0 //")))
+			continue;
+
+		return false;
+	}
+
+	lcPiecesLibrary* Library = lcGetPiecesLibrary();
+	lcStep CurrentStep = GetLastStep();
+	int LineTypeIndex = -1;
+
+	for (const std::unique_ptr<lcPiece>& Piece : mPieces)
+		LineTypeIndex = qMax(LineTypeIndex, Piece->GetLineTypeIndex());
+
+	for (const QString& Line : Lines)
+	{
+		QString Trimmed = Line.trimmed();
+
+		if (Trimmed == QLatin1String("0 STEP"))
+		{
+			CurrentStep++;
+			mFileLines.append(Line);
+			continue;
+		}
+
+		if (!Trimmed.startsWith(QLatin1String("1 ")))
+		{
+			if (!Trimmed.isEmpty())
+				mFileLines.append(Line);
+			continue;
+		}
+
+		QTextStream LineStream(&Trimmed, QIODevice::ReadOnly);
+
+		QString Token;
+		int ColorCode;
+		float IncludeMatrix[12];
+
+		LineStream >> Token >> ColorCode;
+
+		for (int TokenIdx = 0; TokenIdx < 12; TokenIdx++)
+			LineStream >> IncludeMatrix[TokenIdx];
+
+		const QString PartId = LineStream.readAll().trimmed();
+
+		if (PartId.isEmpty())
+			continue;
+
+		const QByteArray CleanId = PartId.toLatin1().toUpper().replace('\\', '/');
+
+		if (Library->IsPrimitive(CleanId.constData()))
+		{
+			mFileLines.append(Line);
+			continue;
+		}
+
+		const lcMatrix44 Transform(lcVector4(IncludeMatrix[3], IncludeMatrix[9], -IncludeMatrix[6], 0.0f), lcVector4(IncludeMatrix[5], IncludeMatrix[11], -IncludeMatrix[8], 0.0f),
+								   lcVector4(-IncludeMatrix[4], -IncludeMatrix[10], IncludeMatrix[7], 0.0f), lcVector4(IncludeMatrix[0], IncludeMatrix[2], -IncludeMatrix[1], 1.0f));
+
+		PieceInfo* Info = Library->FindPiece(PartId.toLatin1().constData(), Project, true, true);
+
+		lcPiece* Piece = new lcPiece(nullptr);
+		Piece->SetLineTypeIndex(++LineTypeIndex);
+		Piece->SetFileLine(mFileLines.size());
+		Piece->SetPieceInfo(Info, PartId, false);
+		Piece->Initialize(Transform, CurrentStep);
+		Piece->SetColorCode(ColorCode);
+
+		if (Piece->mPieceInfo->IsModel() && Piece->mPieceInfo->GetModel()->IncludesModel(this))
+		{
+			delete Piece;
+			continue;
+		}
+
+		AddPiece(Piece);
+	}
+
+	mCurrentStep = CurrentStep;
+	CalculateStep(mCurrentStep);
+	Library->WaitForLoadQueue();
+	Library->mBuffersDirty = true;
+
+	return true;
+}
+/*** LPub3D Mod end ***/
+
 bool lcModel::LoadBinary(lcFile* file)
 {
 	qint32 i, count;
@@ -1916,6 +2270,42 @@ void lcModel::SubModelAddBoundingBoxPoints(const lcMatrix44& WorldMatrix, std::v
 			Piece->SubModelAddBoundingBoxPoints(WorldMatrix, Points);
 }
 
+/*** LPub3D Mod - undo history deltas ***/
+// Only the current undo entry and the first redo entry hold the whole model text.
+// The other entries hold the bytes that differ from their neighbour toward the current entry.
+static void lcSetHistoryDelta(lcModelHistoryEntry* Entry, const QByteArray& Neighbour)
+{
+	if (Entry->Delta)
+		return;
+
+	const QByteArray& File = Entry->File;
+	const int MaxSize = qMin(File.size(), Neighbour.size());
+	int PrefixSize = 0, SuffixSize = 0;
+
+	while (PrefixSize < MaxSize && File.at(PrefixSize) == Neighbour.at(PrefixSize))
+		PrefixSize++;
+
+	while (SuffixSize < MaxSize - PrefixSize && File.at(File.size() - 1 - SuffixSize) == Neighbour.at(Neighbour.size() - 1 - SuffixSize))
+		SuffixSize++;
+
+	Entry->File = File.mid(PrefixSize, File.size() - PrefixSize - SuffixSize);
+	Entry->PrefixSize = PrefixSize;
+	Entry->SuffixSize = SuffixSize;
+	Entry->Delta = true;
+}
+
+static void lcSetHistoryFull(lcModelHistoryEntry* Entry, const QByteArray& Neighbour)
+{
+	if (!Entry->Delta)
+		return;
+
+	Entry->File = Neighbour.left(Entry->PrefixSize) + Entry->File + Neighbour.right(Entry->SuffixSize);
+	Entry->PrefixSize = 0;
+	Entry->SuffixSize = 0;
+	Entry->Delta = false;
+}
+/*** LPub3D Mod end ***/
+
 void lcModel::SaveCheckpoint(const QString& Description)
 {
 	lcModelHistoryEntry* ModelHistoryEntry = new lcModelHistoryEntry();
@@ -1925,6 +2315,11 @@ void lcModel::SaveCheckpoint(const QString& Description)
 	QTextStream Stream(&ModelHistoryEntry->File);
 	SaveLDraw(Stream, false, 0);
 
+/*** LPub3D Mod - undo history deltas ***/
+	if (!mUndoHistory.empty())
+		lcSetHistoryDelta(mUndoHistory[0], ModelHistoryEntry->File);
+/*** LPub3D Mod end ***/
+
 	mUndoHistory.insert(mUndoHistory.begin(), ModelHistoryEntry);
 	for (lcModelHistoryEntry* Entry : mRedoHistory)
 		delete Entry;
@@ -1950,8 +2345,130 @@ void lcModel::SaveCheckpoint(const QString& Description)
 	}
 }
 
-void lcModel::LoadCheckPoint(lcModelHistoryEntry* CheckPoint)
+/*** LPub3D Mod - undo history deltas ***/
+/*
+ * Restore File in place when it differs from Current, the stored text of
+ * the current model, only in piece lines whose pieces have no other saved
+ * lines, such as after a move, rotation or color change. The changed lines
+ * are matched to the pieces in save order and only those pieces are
+ * updated. Returns false, without changing the model, when Current is not
+ * known or the difference needs a full reload.
+ */
+bool lcModel::LoadCheckPointPieces(const QByteArray& File, const QByteArray& Current)
+{
+	if (Current.isEmpty())
+		return false;
+
+	const int MaxSize = qMin(File.size(), Current.size());
+	int PrefixSize = 0, SuffixSize = 0;
+
+	while (PrefixSize < MaxSize && File.at(PrefixSize) == Current.at(PrefixSize))
+		PrefixSize++;
+
+	while (PrefixSize > 0 && Current.at(PrefixSize - 1) != '\n')
+		PrefixSize--;
+
+	while (SuffixSize < MaxSize - PrefixSize && File.at(File.size() - 1 - SuffixSize) == Current.at(Current.size() - 1 - SuffixSize))
+		SuffixSize++;
+
+	while (SuffixSize > 0 && Current.at(Current.size() - 1 - SuffixSize) != '\n')
+		SuffixSize--;
+
+	const QList<QByteArray> CurrentLines = Current.mid(PrefixSize, Current.size() - PrefixSize - SuffixSize).split('\n');
+	const QList<QByteArray> FileLines = File.mid(PrefixSize, File.size() - PrefixSize - SuffixSize).split('\n');
+
+	if (CurrentLines.size() != FileLines.size())
+		return false;
+
+	// piece lines before the first changed line give the index of its piece
+	size_t PieceIndex = (QByteArray(1, '\n') + Current.left(PrefixSize)).count("\n1 ");
+
+	struct lcPieceLine
+	{
+		lcPiece* Piece;
+		quint32 ColorCode;
+		lcMatrix44 Transform;
+	};
+
+	std::vector<lcPieceLine> PieceLines;
+
+	for (int LineIndex = 0; LineIndex < CurrentLines.size(); LineIndex++)
+	{
+		const QByteArray& CurrentLine = CurrentLines[LineIndex];
+
+		if (LineIndex == CurrentLines.size() - 1)
+		{
+			if (!CurrentLine.isEmpty() || !FileLines[LineIndex].isEmpty())
+				return false;
+
+			continue;
+		}
+
+		if (!CurrentLine.startsWith("1 ") || !FileLines[LineIndex].startsWith("1 ") || PieceIndex >= mPieces.size())
+			return false;
+
+		lcPiece* Piece = mPieces[PieceIndex++].get();
+
+		QByteArray PieceText;
+		QTextStream PieceStream(&PieceText);
+		Piece->SaveLDraw(PieceStream);
+		PieceStream.flush();
+
+		if (PieceText != CurrentLine + '\n')
+			return false;
+
+		QString Line = QString::fromLatin1(FileLines[LineIndex]);
+		QTextStream LineStream(&Line, QIODevice::ReadOnly);
+
+		QString Token;
+		int ColorCode;
+		float IncludeMatrix[12];
+
+		LineStream >> Token >> ColorCode;
+
+		for (int TokenIdx = 0; TokenIdx < 12; TokenIdx++)
+			LineStream >> IncludeMatrix[TokenIdx];
+
+		if (LineStream.status() != QTextStream::Ok || LineStream.readAll().trimmed() != Piece->GetID())
+			return false;
+
+		const lcMatrix44 IncludeTransform(lcVector4(IncludeMatrix[3], IncludeMatrix[6], IncludeMatrix[9], 0.0f), lcVector4(IncludeMatrix[4], IncludeMatrix[7], IncludeMatrix[10], 0.0f),
+										  lcVector4(IncludeMatrix[5], IncludeMatrix[8], IncludeMatrix[11], 0.0f), lcVector4(IncludeMatrix[0], IncludeMatrix[1], IncludeMatrix[2], 1.0f));
+		const float* Matrix = IncludeTransform;
+		const lcMatrix44 Transform(lcVector4(Matrix[0], Matrix[2], -Matrix[1], 0.0f), lcVector4(Matrix[8], Matrix[10], -Matrix[9], 0.0f),
+								   lcVector4(-Matrix[4], -Matrix[6], Matrix[5], 0.0f), lcVector4(Matrix[12], Matrix[14], -Matrix[13], 1.0f));
+
+		PieceLines.push_back({ Piece, static_cast<quint32>(ColorCode), Transform });
+	}
+
+	for (const lcPieceLine& PieceLine : PieceLines)
+	{
+		PieceLine.Piece->Initialize(PieceLine.Transform, PieceLine.Piece->GetStepShow());
+		PieceLine.Piece->SetColorCode(PieceLine.ColorCode);
+	}
+
+	// finish with the same state and interface updates as a full reload
+	ClearSelection(false);
+	CalculateStep(mCurrentStep);
+
+	gMainWindow->UpdateTimeline(true, false);
+	gMainWindow->UpdateCurrentStep();
+	gMainWindow->UpdateSelectedObjects(true);
+	UpdateAllViews();
+
+	return true;
+}
+/*** LPub3D Mod end ***/
+
+/*** LPub3D Mod - undo history deltas ***/
+void lcModel::LoadCheckPoint(lcModelHistoryEntry* CheckPoint, const QByteArray& Current)
+/*** LPub3D Mod end ***/
 {
+/*** LPub3D Mod - undo history deltas ***/
+	if (LoadCheckPointPieces(CheckPoint->File, Current))
+		return;
+/*** LPub3D Mod end ***/
+
 	lcPiecesLibrary* Library = lcGetPiecesLibrary();
 	std::vector<PieceInfo*> LoadedInfos;
 
@@ -4892,9 +5409,16 @@ void lcModel::UndoAction()
 
 	lcModelHistoryEntry* Undo = mUndoHistory.front();
 	mUndoHistory.erase(mUndoHistory.begin());
+/*** LPub3D Mod - undo history deltas ***/
+	lcSetHistoryFull(mUndoHistory[0], Undo->File);
+	if (!mRedoHistory.empty())
+		lcSetHistoryDelta(mRedoHistory[0], Undo->File);
+/*** LPub3D Mod end ***/
 	mRedoHistory.insert(mRedoHistory.begin(), Undo);
 
-	LoadCheckPoint(mUndoHistory[0]);
+/*** LPub3D Mod - undo history deltas ***/
+	LoadCheckPoint(mUndoHistory[0], Undo->File);
+/*** LPub3D Mod end ***/
 
 	gMainWindow->UpdateModified(IsModified());
 	gMainWindow->UpdateUndoRedo(mUndoHistory.size() > 1 ? mUndoHistory[0]->Description : nullptr, !mRedoHistory.empty() ? mRedoHistory[0]->Description : nullptr);
@@ -4910,9 +5434,18 @@ void lcModel::RedoAction()
 
 	lcModelHistoryEntry* Redo = mRedoHistory.front();
 	mRedoHistory.erase(mRedoHistory.begin());
+/*** LPub3D Mod - undo history deltas ***/
+	const QByteArray Current = !mUndoHistory.empty() ? mUndoHistory[0]->File : QByteArray();
+	if (!mRedoHistory.empty())
+		lcSetHistoryFull(mRedoHistory[0], Redo->File);
+	if (!mUndoHistory.empty())
+		lcSetHistoryDelta(mUndoHistory[0], Redo->File);
+/*** LPub3D Mod end ***/
 	mUndoHistory.insert(mUndoHistory.begin(), Redo);
 
-	LoadCheckPoint(Redo);
+/*** LPub3D Mod - undo history deltas ***/
+	LoadCheckPoint(Redo, Current);
+/*** LPub3D Mod end ***/
 
 	gMainWindow->UpdateModified(IsModified());
 	gMainWindow->UpdateUndoRedo(mUndoHistory.size() > 1 ? mUndoHistory[0]->Description : nullptr, !mRedoHistory.empty() ? mRedoHistory[0]->Description : nullptr);
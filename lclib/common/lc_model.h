@@ -117,6 +117,11 @@ struct lcModelHistoryEntry
 {
 	QByteArray File;
 	QString Description;
+/*** LPub3D Mod - undo history deltas ***/
+	bool Delta = false;
+	int PrefixSize = 0;
+	int SuffixSize = 0;
+/*** LPub3D Mod end ***/
 };
 
 class lcModel
@@ -278,6 +283,9 @@ public:
 
 	void SaveLDraw(QTextStream& Stream, bool SelectedOnly, lcStep LastStep) const;
 	void LoadLDraw(QIODevice& Device, Project* Project);
+/*** LPub3D Mod - native render session ***/
+	bool AppendLDrawPieces(const QStringList& Lines, Project* Project);
+/*** LPub3D Mod end ***/
 	bool LoadBinary(lcFile* File);
 	bool LoadLDD(const QString& FileData);
 	bool LoadInventory(const QByteArray& Inventory);
@@ -454,7 +462,10 @@ protected:
 	void DeleteModel();
 	void DeleteHistory();
 	void SaveCheckpoint(const QString& Description);
-	void LoadCheckPoint(lcModelHistoryEntry* CheckPoint);
+/*** LPub3D Mod - undo history deltas ***/
+	void LoadCheckPoint(lcModelHistoryEntry* CheckPoint, const QByteArray& Current = QByteArray());
+	bool LoadCheckPointPieces(const QByteArray& File, const QByteArray& Current);
+/*** LPub3D Mod end ***/
 
 	QString GetGroupName(const QString& Prefix);
 	void RemoveEmptyGroups();
@@ -146,6 +146,10 @@ void lcPartSelectionListModel::SetCategory(int CategoryIndex)
 	for (size_t PartIndex = 0; PartIndex < SingleParts.size(); PartIndex++)
 		mParts[PartIndex].Info = SingleParts[PartIndex];
 
+/*** LPub3D Mod - part search index ***/
+	mSearchIndex.Clear();
+/*** LPub3D Mod end ***/
+
 	endResetModel();
 
 	SetFilter(mFilter);
@@ -172,6 +176,10 @@ void lcPartSelectionListModel::SetModelsCategory()
 
 	std::sort(mParts.begin(), mParts.end(), lcPartSortFunc);
 
+/*** LPub3D Mod - part search index ***/
+	mSearchIndex.Clear();
+/*** LPub3D Mod end ***/
+
 	endResetModel();
 
 	SetFilter(mFilter);
@@ -200,6 +208,10 @@ void lcPartSelectionListModel::SetPaletteCategory(int SetIndex)
 	for (PieceInfo* Info : PartsList)
 		mParts.emplace_back().Info = Info;
 
+/*** LPub3D Mod - part search index ***/
+	mSearchIndex.Clear();
+/*** LPub3D Mod end ***/
+
 	endResetModel();
 
 	SetFilter(mFilter);
@@ -228,6 +240,10 @@ void lcPartSelectionListModel::SetCurrentModelCategory()
 
 	std::sort(mParts.begin(), mParts.end(), lcPartSortFunc);
 
+/*** LPub3D Mod - part search index ***/
+	mSearchIndex.Clear();
+/*** LPub3D Mod end ***/
+
 	endResetModel();
 
 	SetFilter(mFilter);
@@ -250,11 +266,179 @@ void lcPartSelectionListModel::SetCustomParts(const std::vector<PieceInfo*>& Par
 
 	std::sort(mParts.begin(), mParts.end(), lcPartSortFunc);
 
+/*** LPub3D Mod - part search index ***/
+	mSearchIndex.Clear();
+/*** LPub3D Mod end ***/
+
 	endResetModel();
 
 	SetFilter(mFilter);
 }
 
+/*** LPub3D Mod - part search index ***/
+std::string lcPartSearchIndex::ToLower(const char* Text)
+{
+	std::string Lower(Text);
+
+	for (char& Char : Lower)
+		if (Char >= 'A' && Char <= 'Z')
+			Char += 'a' - 'A';
+
+	return Lower;
+}
+
+/*
+ * Keep the squeezed description and the lower case description and file name
+ * of each part and index every lower case trigram of both.
+ */
+void lcPartSearchIndex::Build(const std::vector<lcPartSelectionListModelEntry>& Parts)
+{
+	mDescriptions.clear();
+	mLowerDescriptions.clear();
+	mLowerFileNames.clear();
+	mTrigrams.clear();
+
+	mDescriptions.reserve(Parts.size());
+	mLowerDescriptions.reserve(Parts.size());
+	mLowerFileNames.reserve(Parts.size());
+
+	for (size_t PartIdx = 0; PartIdx < Parts.size(); PartIdx++)
+	{
+		const PieceInfo* Info = Parts[PartIdx].Info;
+		std::string Description;
+		Description.reserve(strlen(Info->m_strDescription));
+
+		for (const char* Src = Info->m_strDescription; *Src; Src++)
+			if (*Src != ' ' || *(Src + 1) != ' ')
+				Description += *Src;
+
+		mDescriptions.emplace_back(Description);
+		mLowerDescriptions.emplace_back(ToLower(Description.c_str()));
+		mLowerFileNames.emplace_back(ToLower(Info->mFileName));
+
+		for (const std::string* Text : { &mLowerDescriptions.back(), &mLowerFileNames.back() })
+		{
+			for (size_t CharIdx = 0; CharIdx + 3 <= Text->size(); CharIdx++)
+			{
+				std::vector<quint32>& Posting = mTrigrams[GetTrigram(Text->c_str() + CharIdx)];
+
+				if (Posting.empty() || Posting.back() != PartIdx)
+					Posting.push_back(quint32(PartIdx));
+			}
+		}
+	}
+
+	mValid = true;
+}
+
+/*
+ * Collect the parts holding every trigram of Literals, in index order.
+ * Returns false when no literal is long enough to use the index.
+ */
+bool lcPartSearchIndex::GetCandidates(const std::vector<std::string>& Literals, std::vector<quint32>& Candidates) const
+{
+	std::vector<const std::vector<quint32>*> Postings;
+
+	for (const std::string& Literal : Literals)
+	{
+		const std::string Lower = ToLower(Literal.c_str());
+
+		for (size_t CharIdx = 0; CharIdx + 3 <= Lower.size(); CharIdx++)
+		{
+			const auto Posting = mTrigrams.find(GetTrigram(Lower.c_str() + CharIdx));
+
+			if (Posting == mTrigrams.end())
+			{
+				Candidates.clear();
+				return true;
+			}
+
+			Postings.push_back(&Posting->second);
+		}
+	}
+
+	if (Postings.empty())
+		return false;
+
+	std::sort(Postings.begin(), Postings.end(), [](const std::vector<quint32>* a, const std::vector<quint32>* b)
+	{
+		return a->size() < b->size();
+	});
+
+	Candidates = *Postings[0];
+
+	for (size_t PostingIdx = 1; PostingIdx < Postings.size() && !Candidates.empty(); PostingIdx++)
+	{
+		std::vector<quint32> Intersection;
+		std::set_intersection(Candidates.begin(), Candidates.end(), Postings[PostingIdx]->begin(), Postings[PostingIdx]->end(), std::back_inserter(Intersection));
+		Candidates.swap(Intersection);
+	}
+
+	return true;
+}
+
+/*
+ * Literal runs every match of Pattern must contain. Patterns with
+ * alternation, groups, classes or escapes return no literals.
+ */
+std::vector<std::string> lcPartSearchIndex::GetPatternLiterals(const QByteArray& Pattern, bool Wildcard)
+{
+	std::vector<std::string> Literals;
+	std::string Literal;
+
+	auto AddLiteral = [&Literals, &Literal]()
+	{
+		if (Literal.size() >= 3)
+			Literals.emplace_back(Literal);
+		Literal.clear();
+	};
+
+	if (Wildcard)
+	{
+		if (Pattern.contains('[') || Pattern.contains('\\'))
+			return Literals;
+
+		for (const char Char : Pattern)
+		{
+			if (Char == '*' || Char == '?')
+				AddLiteral();
+			else
+				Literal += Char;
+		}
+	}
+	else
+	{
+		for (const char Char : { '|', '(', '[', '\\' })
+			if (Pattern.contains(Char))
+				return Literals;
+
+		for (int CharIdx = 0; CharIdx < Pattern.size(); CharIdx++)
+		{
+			const char Char = Pattern[CharIdx];
+			const char Next = CharIdx + 1 < Pattern.size() ? Pattern[CharIdx + 1] : 0;
+
+			if (Char == '{')
+			{
+				AddLiteral();
+
+				while (CharIdx < Pattern.size() && Pattern[CharIdx] != '}')
+					CharIdx++;
+			}
+			else if (strchr(".^$*+?}", Char))
+				AddLiteral();
+			else if (Next == '?' || Next == '*' || Next == '{')
+				AddLiteral();
+			else
+				Literal += Char;
+		}
+	}
+
+	AddLiteral();
+
+	return Literals;
+}
+/*** LPub3D Mod end ***/
+
 void lcPartSelectionListModel::SetFilter(const QString& Filter)
 {
 	mFilter = Filter.toLatin1();
@@ -273,6 +457,82 @@ void lcPartSelectionListModel::SetFilter(const QString& Filter)
 	QRegExp FilterRx(mFilter, CaseSensitive, PatternSyntax);
 #endif
 
+/*** LPub3D Mod - part search index ***/
+	bool Incremental = mSearchIndex.IsValid();
+
+	const int FilterOptions = int(mPartFilterType) | (mCaseSensitiveFilter << 4) | (mFileNameFilter << 5) | (mPartDescriptionFilter << 6);
+
+	// a fixed string filter that only grew can only match a subset of the previous matches
+	Incremental &= FixedStringFilter && !mMatchedFilter.isEmpty() && mFilter.contains(mMatchedFilter) &&
+	               FilterOptions == mMatchedFilterOptions && mFilterMatches.size() == mParts.size();
+
+	const std::string LowerFilter = lcPartSearchIndex::ToLower(mFilter.constData());
+
+	auto FilterMatch = [&](size_t PartIdx) -> bool
+	{
+		const std::string& Description = mSearchIndex.GetDescription(PartIdx);
+		const char* FileName = mParts[PartIdx].Info->mFileName;
+
+		if (FixedStringFilter)
+		{
+			if (mCaseSensitiveFilter)
+				return (mPartDescriptionFilter && strstr(Description.c_str(), mFilter)) || (mFileNameFilter && strstr(FileName, mFilter));
+			else
+				return (mPartDescriptionFilter && strstr(mSearchIndex.GetLowerDescription(PartIdx).c_str(), LowerFilter.c_str())) ||
+				       (mFileNameFilter && strstr(mSearchIndex.GetLowerFileName(PartIdx).c_str(), LowerFilter.c_str()));
+		}
+
+		if (DefaultFilter)
+			return QString(Description.c_str()).contains(FilterRx) || QString(FileName).contains(FilterRx);
+		else if (mFileNameFilter)
+			return QString(FileName).contains(FilterRx);
+		else if (mPartDescriptionFilter)
+			return QString(Description.c_str()).contains(FilterRx);
+
+		return true;
+	};
+
+	const bool FilterParts = !mFilter.isEmpty() && (mFileNameFilter || mPartDescriptionFilter);
+	std::vector<char> FilterMatches(mParts.size(), !FilterParts);
+
+	if (Incremental)
+	{
+		for (size_t PartIdx = 0; PartIdx < mParts.size(); PartIdx++)
+			if (mFilterMatches[PartIdx])
+				FilterMatches[PartIdx] = FilterMatch(PartIdx);
+	}
+	else if (FilterParts)
+	{
+		// the index is built on the first filter that actually matches parts
+		if (!mSearchIndex.IsValid())
+			mSearchIndex.Build(mParts);
+
+		std::vector<std::string> Literals;
+
+		if (FixedStringFilter)
+			Literals.emplace_back(mFilter.constData());
+		else
+			Literals = lcPartSearchIndex::GetPatternLiterals(mFilter, WildcardFilter);
+
+		std::vector<quint32> Candidates;
+
+		if (mSearchIndex.GetCandidates(Literals, Candidates))
+		{
+			for (quint32 PartIdx : Candidates)
+				FilterMatches[PartIdx] = FilterMatch(PartIdx);
+		}
+		else
+		{
+			for (size_t PartIdx = 0; PartIdx < mParts.size(); PartIdx++)
+				FilterMatches[PartIdx] = FilterMatch(PartIdx);
+		}
+	}
+
+	mFilterMatches.swap(FilterMatches);
+	mMatchedFilter = mFilter;
+	mMatchedFilterOptions = FilterOptions;
+/*** LPub3D Mod end ***/
+
 	for (size_t PartIdx = 0; PartIdx < mParts.size(); PartIdx++)
 	{
 		PieceInfo* Info = mParts[PartIdx].Info;
@@ -284,48 +544,10 @@ void lcPartSelectionListModel::SetFilter(const QString& Filter)
 			Visible = false;
 		else if (!mShowPartAliases && Info->m_strDescription[0] == '=')
 			Visible = false;
-		else if (!mFilter.isEmpty())
-		{
-			char Description[sizeof(Info->m_strDescription)];
-			char* Src = Info->m_strDescription;
-			char* Dst = Description;
-
-			for (;;)
-			{
-				*Dst = *Src;
-
-				if (*Src == ' ' && *(Src + 1) == ' ')
-					Src++;
-				else if (*Src == 0)
-					break;
-
-				Src++;
-				Dst++;
-			}
-
-			if (FixedStringFilter)
-			{
-				if (DefaultFilter)
-					if (mCaseSensitiveFilter)
-						Visible = strstr(Description, mFilter) || strstr(Info->mFileName, mFilter);
-					else
-						Visible = strcasestr(Description, mFilter) || strcasestr(Info->mFileName, mFilter);
-				else if (mFileNameFilter)
-					Visible = mCaseSensitiveFilter ? strstr(Info->mFileName, mFilter) : strcasestr(Info->mFileName, mFilter);
-				else if (mPartDescriptionFilter)
-					Visible = mCaseSensitiveFilter ? strstr(Description, mFilter) : strcasestr(Description, mFilter);
-			}
-			else
-			{
-				if (DefaultFilter)
-					Visible = QString(Description).contains(FilterRx) || QString(Info->mFileName).contains(FilterRx);
-				else if (mFileNameFilter)
-					Visible = QString(Info->mFileName).contains(FilterRx);
-				else if (mPartDescriptionFilter)
-					Visible = QString(Description).contains(FilterRx);
-			}
-
-		}
+/*** LPub3D Mod - part search index ***/
+		else
+			Visible = mFilterMatches[PartIdx];
+/*** LPub3D Mod end ***/
 
 		mListView->setRowHidden((int)PartIdx, !Visible);
 	}
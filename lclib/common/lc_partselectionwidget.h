@@ -61,6 +61,56 @@ struct lcPartSelectionListModelEntry
 	lcPartThumbnailId ThumbnailId = lcPartThumbnailId::Invalid;
 };
 
+/*** LPub3D Mod - part search index ***/
+class lcPartSearchIndex
+{
+public:
+	void Build(const std::vector<lcPartSelectionListModelEntry>& Parts);
+
+	void Clear()
+	{
+		mValid = false;
+	}
+
+	bool IsValid() const
+	{
+		return mValid;
+	}
+
+	const std::string& GetDescription(size_t Index) const
+	{
+		return mDescriptions[Index];
+	}
+
+	const std::string& GetLowerDescription(size_t Index) const
+	{
+		return mLowerDescriptions[Index];
+	}
+
+	const std::string& GetLowerFileName(size_t Index) const
+	{
+		return mLowerFileNames[Index];
+	}
+
+	bool GetCandidates(const std::vector<std::string>& Literals, std::vector<quint32>& Candidates) const;
+
+	static std::string ToLower(const char* Text);
+	static std::vector<std::string> GetPatternLiterals(const QByteArray& Pattern, bool Wildcard);
+
+protected:
+	static quint32 GetTrigram(const char* Text)
+	{
+		return (quint32(quint8(Text[0])) << 16) | (quint32(quint8(Text[1])) << 8) | quint32(quint8(Text[2]));
+	}
+
+	std::vector<std::string> mDescriptions;
+	std::vector<std::string> mLowerDescriptions;
+	std::vector<std::string> mLowerFileNames;
+	std::unordered_map<quint32, std::vector<quint32>> mTrigrams;
+	bool mValid = false;
+};
+/*** LPub3D Mod end ***/
+
 class lcPartSelectionListModel : public QAbstractListModel
 {
 	Q_OBJECT
@@ -181,6 +231,12 @@ protected:
 	bool mFileNameFilter;
 	bool mPartDescriptionFilter;
 	QByteArray mFilter;
+/*** LPub3D Mod - part search index ***/
+	lcPartSearchIndex mSearchIndex;
+	std::vector<char> mFilterMatches;
+	QByteArray mMatchedFilter;
+	int mMatchedFilterOptions = -1;
+/*** LPub3D Mod end ***/
 };
 
 class lcPartSelectionListView : public QListView
@@ -39,6 +39,10 @@ struct lcTranslucentMeshInstance
 
 class lcScene
 {
+/*** LPub3D Mod - native software renderer ***/
+	friend class lcSoftwareRenderer;
+/*** LPub3D Mod end ***/
+
 public:
 	lcScene();
 
@@ -0,0 +1,706 @@
+#include "lc_global.h"
+#include "lc_softwarerenderer.h"
+#include "lc_scene.h"
+#include "lc_mesh.h"
+#include "lc_colors.h"
+#include "lc_application.h"
+#include <QtConcurrent>
+
+static inline quint32 lcGetMeshIndex(const lcMesh* Mesh, int IndexOffset, int Index)
+{
+	if (Mesh->mIndexType == GL_UNSIGNED_SHORT)
+		return static_cast<const quint16*>(Mesh->mIndexData)[IndexOffset / sizeof(quint16) + Index];
+	else
+		return static_cast<const quint32*>(Mesh->mIndexData)[IndexOffset / sizeof(quint32) + Index];
+}
+
+static inline float lcEdgeFunction(float x0, float y0, float x1, float y1, float x, float y)
+{
+	return (x1 - x0) * (y - y0) - (y1 - y0) * (x - x0);
+}
+
+static inline bool lcIsTopLeftEdge(float x0, float y0, float x1, float y1)
+{
+	const float dy = y1 - y0;
+	return dy > 0.0f || (dy == 0.0f && x1 - x0 > 0.0f);
+}
+
+lcSoftwareRenderer::lcSoftwareRenderer(int Width, int Height)
+	: mWidth(qMax(Width, 1)), mHeight(qMax(Height, 1)), mLineWidth(1.0f), mBackgroundColor(0.0f, 0.0f, 0.0f, 0.0f)
+{
+}
+
+bool lcSoftwareRenderer::Render(const lcScene* Scene, const lcMatrix44& ProjectionMatrix, QImage& Image)
+{
+	const lcMatrix44& ViewMatrix = Scene->mViewMatrix;
+	const lcMatrix44 InverseViewMatrix = lcMatrix44AffineInverse(ViewMatrix);
+
+	mViewProjectionMatrix = lcMul(ViewMatrix, ProjectionMatrix);
+	mEyePosition = lcMul30(-ViewMatrix.GetTranslation(), InverseViewMatrix);
+	mLightPosition = mEyePosition + lcMul30(lcVector3(300.0f, 300.0f, 0.0f), InverseViewMatrix);
+
+	mPrimitives.clear();
+
+	const lcPreferences& Preferences = lcGetPreferences();
+	const bool DrawLines = Preferences.mDrawEdgeLines && Preferences.mLineWidth > 0.0f;
+	const bool DrawConditional = Preferences.mDrawConditionalLines && Preferences.mLineWidth > 0.0f;
+
+	// Same pass order as lcScene::Draw(), the depth only fade prepass is not needed since faded
+	// opaque triangles are already moved to the translucent list by lcScene::AddMesh().
+	if (Scene->mShadingMode == lcShadingMode::Wireframe || Scene->mShadingMode == lcShadingMode::Flat)
+	{
+		AddOpaqueMeshes(Scene, false, LC_SOFTWARE_TRIANGLES | (DrawLines ? LC_SOFTWARE_LINES : 0), true, true);
+
+		if (DrawConditional)
+			AddOpaqueMeshes(Scene, false, LC_SOFTWARE_CONDITIONAL_LINES, true, true);
+
+		AddTranslucentMeshes(Scene, false, true, true);
+	}
+	else
+	{
+		if (DrawLines)
+			AddOpaqueMeshes(Scene, false, LC_SOFTWARE_LINES, true, true);
+
+		if (DrawConditional)
+			AddOpaqueMeshes(Scene, false, LC_SOFTWARE_CONDITIONAL_LINES, true, true);
+
+		AddOpaqueMeshes(Scene, true, LC_SOFTWARE_TRIANGLES, true, true);
+
+		AddTranslucentMeshes(Scene, true, true, true);
+	}
+
+	mColorBuffer.assign(static_cast<size_t>(mWidth) * mHeight, mBackgroundColor);
+	mDepthBuffer.assign(static_cast<size_t>(mWidth) * mHeight, 1.0f);
+
+	BinPrimitives();
+
+	QtConcurrent::blockingMap(mTiles, [this](lcSoftwareTile& Tile)
+	{
+		RasterizeTile(Tile);
+	});
+
+	Image = QImage(mWidth, mHeight, QImage::Format_ARGB32);
+
+	if (Image.isNull())
+		return false;
+
+	for (int y = 0; y < mHeight; y++)
+	{
+		QRgb* Line = reinterpret_cast<QRgb*>(Image.scanLine(y));
+		const lcVector4* Color = &mColorBuffer[static_cast<size_t>(y) * mWidth];
+
+		for (int x = 0; x < mWidth; x++, Color++)
+		{
+			const int Red = static_cast<int>(lcClamp(Color->x, 0.0f, 1.0f) * 255.0f + 0.5f);
+			const int Green = static_cast<int>(lcClamp(Color->y, 0.0f, 1.0f) * 255.0f + 0.5f);
+			const int Blue = static_cast<int>(lcClamp(Color->z, 0.0f, 1.0f) * 255.0f + 0.5f);
+			const int Alpha = static_cast<int>(lcClamp(Color->w, 0.0f, 1.0f) * 255.0f + 0.5f);
+
+			Line[x] = qRgba(Red, Green, Blue, Alpha);
+		}
+	}
+
+	mPrimitives.clear();
+	mTiles.clear();
+
+	return true;
+}
+
+void lcSoftwareRenderer::AddOpaqueMeshes(const lcScene* Scene, bool DrawLit, int PrimitiveTypes, bool DrawFaded, bool DrawNonFaded)
+{
+	const lcPreferences& Preferences = lcGetPreferences();
+	const lcVector4 FocusedColor = lcVector4FromColor(Preferences.mObjectFocusedColor);
+	const lcVector4 SelectedColor = lcVector4FromColor(Preferences.mBuildModificationEnabled ? Preferences.mBMObjectSelectedColor : Preferences.mObjectSelectedColor);
+
+	for (const int MeshIndex : Scene->mOpaqueMeshes)
+	{
+		const lcRenderMesh& RenderMesh = Scene->mRenderMeshes[MeshIndex];
+		const lcMesh* Mesh = RenderMesh.Mesh;
+		const lcMeshLod& Lod = Mesh->mLods[RenderMesh.LodIndex];
+
+		if (!DrawFaded && RenderMesh.State == lcRenderMeshState::Faded)
+			continue;
+
+		if (!DrawNonFaded && RenderMesh.State != lcRenderMeshState::Faded)
+			continue;
+
+		for (int SectionIdx = 0; SectionIdx < Lod.NumSections; SectionIdx++)
+		{
+			const lcMeshSection* const Section = &Lod.Sections[SectionIdx];
+			int ColorIndex = Section->ColorIndex;
+			lcVector4 Color;
+
+			if (Section->PrimitiveType & (LC_MESH_TRIANGLES | LC_MESH_TEXTURED_TRIANGLES))
+			{
+				if ((PrimitiveTypes & LC_SOFTWARE_TRIANGLES) == 0)
+					continue;
+
+				if (ColorIndex == gDefaultColor)
+					ColorIndex = RenderMesh.ColorIndex;
+
+				if (lcIsColorTranslucent(ColorIndex))
+					continue;
+
+				const lcVector4& Value = gColorList[ColorIndex].Value;
+
+				switch (RenderMesh.State)
+				{
+				case lcRenderMeshState::Default:
+				case lcRenderMeshState::Highlighted:
+					Color = Value;
+					break;
+
+				case lcRenderMeshState::Selected:
+					Color = lcVector4(lcVector3(Value * 0.5f + SelectedColor * 0.5f), Value.w);
+					break;
+
+				case lcRenderMeshState::Focused:
+					Color = lcVector4(lcVector3(Value * 0.5f + FocusedColor * 0.5f), Value.w);
+					break;
+
+				case lcRenderMeshState::Faded:
+					if (Scene->mTranslucentFade)
+						continue;
+					Color = Value * Scene->mFadeColor;
+					break;
+				}
+
+				AddSection(RenderMesh, Section, Color, DrawLit, false, 0.5f);
+			}
+			else if (Section->PrimitiveType & (LC_MESH_LINES | LC_MESH_CONDITIONAL_LINES))
+			{
+				if (Section->PrimitiveType == LC_MESH_LINES && (PrimitiveTypes & LC_SOFTWARE_LINES) == 0)
+					continue;
+
+				if (Section->PrimitiveType == LC_MESH_CONDITIONAL_LINES && (PrimitiveTypes & LC_SOFTWARE_CONDITIONAL_LINES) == 0)
+					continue;
+
+				switch (RenderMesh.State)
+				{
+				case lcRenderMeshState::Default:
+					Color = ColorIndex != gEdgeColor ? gColorList[ColorIndex].Value : gColorList[RenderMesh.ColorIndex].Edge;
+					break;
+
+				case lcRenderMeshState::Selected:
+					Color = SelectedColor;
+					break;
+
+				case lcRenderMeshState::Focused:
+					Color = FocusedColor;
+					break;
+
+				case lcRenderMeshState::Highlighted:
+					Color = Scene->mHighlightColor;
+					break;
+
+				case lcRenderMeshState::Faded:
+					Color = gColorList[ColorIndex].Edge * Scene->mFadeColor;
+					break;
+				}
+
+				AddSection(RenderMesh, Section, Color, false, false, 0.0f);
+			}
+		}
+	}
+}
+
+void lcSoftwareRenderer::AddTranslucentMeshes(const lcScene* Scene, bool DrawLit, bool DrawFaded, bool DrawNonFaded)
+{
+	const lcPreferences& Preferences = lcGetPreferences();
+	const lcVector4 FocusedColor = lcVector4FromColor(Preferences.mObjectFocusedColor);
+	const lcVector4 SelectedColor = lcVector4FromColor(Preferences.mObjectSelectedColor);
+
+	for (const lcTranslucentMeshInstance& MeshInstance : Scene->mTranslucentMeshes)
+	{
+		const lcRenderMesh& RenderMesh = Scene->mRenderMeshes[MeshInstance.RenderMeshIndex];
+
+		if (!DrawFaded && RenderMesh.State == lcRenderMeshState::Faded)
+			continue;
+
+		if (!DrawNonFaded && RenderMesh.State != lcRenderMeshState::Faded)
+			continue;
+
+		int ColorIndex = MeshInstance.Section->ColorIndex;
+
+		if (ColorIndex == gDefaultColor)
+			ColorIndex = RenderMesh.ColorIndex;
+
+		const lcVector4& Value = gColorList[ColorIndex].Value;
+		lcVector4 Color;
+
+		switch (RenderMesh.State)
+		{
+		case lcRenderMeshState::Default:
+		case lcRenderMeshState::Highlighted:
+			Color = Value;
+			break;
+
+		case lcRenderMeshState::Selected:
+			Color = lcVector4(lcVector3(Value * 0.5f + SelectedColor * 0.5f), Value.w);
+			break;
+
+		case lcRenderMeshState::Focused:
+			Color = lcVector4(lcVector3(Value * 0.5f + FocusedColor * 0.5f), Value.w);
+			break;
+
+		case lcRenderMeshState::Faded:
+			Color = Value * Scene->mFadeColor;
+			break;
+		}
+
+		AddSection(RenderMesh, MeshInstance.Section, Color, DrawLit, true, 0.25f);
+	}
+}
+
+void lcSoftwareRenderer::AddSection(const lcRenderMesh& RenderMesh, const lcMeshSection* Section, const lcVector4& Color, bool Lit, bool Blend, float DepthFactor)
+{
+	const lcMesh* Mesh = RenderMesh.Mesh;
+	const lcMatrix44& WorldMatrix = RenderMesh.WorldMatrix;
+	const lcMatrix44 WorldViewProjectionMatrix = lcMul(WorldMatrix, mViewProjectionMatrix);
+
+	if (Section->PrimitiveType == LC_MESH_CONDITIONAL_LINES)
+	{
+		const lcVertexConditional* Vertices = Mesh->GetConditionalVertexData();
+
+		for (int Idx = 0; Idx + 1 < Section->NumIndices; Idx += 2)
+		{
+			const lcVertexConditional& Vertex1 = Vertices[lcGetMeshIndex(Mesh, Section->IndexOffset, Idx)];
+			const lcVertexConditional& Vertex2 = Vertices[lcGetMeshIndex(Mesh, Section->IndexOffset, Idx + 1)];
+
+			// Same visibility test as unlit_color_conditional_vs.glsl, evaluated once per line.
+			const lcVector4 p1 = lcMul4(lcVector4(Vertex1.Position1, 1.0f), WorldViewProjectionMatrix);
+			const lcVector4 p2 = lcMul4(lcVector4(Vertex1.Position2, 1.0f), WorldViewProjectionMatrix);
+			const lcVector4 p3 = lcMul4(lcVector4(Vertex1.Position3, 1.0f), WorldViewProjectionMatrix);
+			const lcVector4 p4 = lcMul4(lcVector4(Vertex1.Position4, 1.0f), WorldViewProjectionMatrix);
+
+			if (p1.w == 0.0f || p2.w == 0.0f || p3.w == 0.0f || p4.w == 0.0f)
+				continue;
+
+			const lcVector2 Line(p2.x / p2.w - p1.x / p1.w, p2.y / p2.w - p1.y / p1.w);
+			const lcVector2 Cond1(p3.x / p3.w - p1.x / p1.w, p3.y / p3.w - p1.y / p1.w);
+			const lcVector2 Cond2(p4.x / p4.w - p1.x / p1.w, p4.y / p4.w - p1.y / p1.w);
+
+			const float Cross1 = Line.x * Cond1.y - Line.y * Cond1.x;
+			const float Cross2 = Line.x * Cond2.y - Line.y * Cond2.x;
+
+			if (Cross1 * Cross2 < 0.0f)
+				continue;
+
+			AddLine(p1, lcMul4(lcVector4(Vertex2.Position1, 1.0f), WorldViewProjectionMatrix), Color);
+		}
+
+		return;
+	}
+
+	const bool Textured = Section->PrimitiveType == LC_MESH_TEXTURED_TRIANGLES;
+	const lcVertex* Vertices = Mesh->GetVertexData();
+	const lcVertexTextured* TexturedVertices = Mesh->GetTexturedVertexData();
+
+	const auto GetVertex = [&](int Idx, lcVector3& Position, quint32& Normal)
+	{
+		const quint32 Index = lcGetMeshIndex(Mesh, Section->IndexOffset, Idx);
+
+		if (Textured)
+		{
+			Position = TexturedVertices[Index].Position;
+			Normal = TexturedVertices[Index].Normal;
+		}
+		else
+		{
+			Position = Vertices[Index].Position;
+			Normal = Vertices[Index].Normal;
+		}
+	};
+
+	if (Section->PrimitiveType == LC_MESH_LINES)
+	{
+		for (int Idx = 0; Idx + 1 < Section->NumIndices; Idx += 2)
+		{
+			lcVector3 Position1, Position2;
+			quint32 Normal1, Normal2;
+
+			GetVertex(Idx, Position1, Normal1);
+			GetVertex(Idx + 1, Position2, Normal2);
+
+			AddLine(lcMul4(lcVector4(Position1, 1.0f), WorldViewProjectionMatrix), lcMul4(lcVector4(Position2, 1.0f), WorldViewProjectionMatrix), Color);
+		}
+
+		return;
+	}
+
+	for (int Idx = 0; Idx + 2 < Section->NumIndices; Idx += 3)
+	{
+		lcVector4 Clip[3];
+		lcVector3 Position[3];
+		lcVector3 Normal[3];
+
+		for (int VertexIdx = 0; VertexIdx < 3; VertexIdx++)
+		{
+			lcVector3 LocalPosition;
+			quint32 PackedNormal;
+
+			GetVertex(Idx + VertexIdx, LocalPosition, PackedNormal);
+
+			Clip[VertexIdx] = lcMul4(lcVector4(LocalPosition, 1.0f), WorldViewProjectionMatrix);
+
+			if (Lit)
+			{
+				Position[VertexIdx] = lcMul31(LocalPosition, WorldMatrix);
+				Normal[VertexIdx] = lcMul30(lcUnpackNormal(PackedNormal), WorldMatrix);
+			}
+		}
+
+		AddTriangle(Clip, Position, Normal, Color, Lit, Blend, DepthFactor);
+	}
+}
+
+lcSoftwareRenderer::lcSoftwareVertex lcSoftwareRenderer::ToScreen(const lcVector4& Clip, const lcVector3& Position, const lcVector3& Normal) const
+{
+	lcSoftwareVertex Vertex;
+
+	Vertex.InvW = 1.0f / Clip.w;
+	Vertex.x = (Clip.x * Vertex.InvW + 1.0f) * 0.5f * mWidth;
+	Vertex.y = (1.0f - Clip.y * Vertex.InvW) * 0.5f * mHeight;
+	Vertex.z = (Clip.z * Vertex.InvW + 1.0f) * 0.5f;
+	Vertex.Position = Position;
+	Vertex.Normal = Normal;
+
+	return Vertex;
+}
+
+void lcSoftwareRenderer::AddTriangle(const lcVector4 (&Clip)[3], const lcVector3 (&Position)[3], const lcVector3 (&Normal)[3], const lcVector4& Color, bool Lit, bool Blend, float DepthFactor)
+{
+	// Clip against the near plane (z >= -w), everything else is handled by the screen and depth bounds.
+	lcVector4 InClip[4];
+	lcVector3 InPosition[4], InNormal[4];
+	int InCount = 0;
+
+	for (int VertexIdx = 0; VertexIdx < 3; VertexIdx++)
+	{
+		const int NextIdx = (VertexIdx + 1) % 3;
+		const float Distance = Clip[VertexIdx].z + Clip[VertexIdx].w;
+		const float NextDistance = Clip[NextIdx].z + Clip[NextIdx].w;
+
+		if (Distance >= 0.0f)
+		{
+			InClip[InCount] = Clip[VertexIdx];
+			InPosition[InCount] = Position[VertexIdx];
+			InNormal[InCount] = Normal[VertexIdx];
+			InCount++;
+		}
+
+		if ((Distance >= 0.0f) != (NextDistance >= 0.0f))
+		{
+			const float t = Distance / (Distance - NextDistance);
+
+			InClip[InCount] = Clip[VertexIdx] + (Clip[NextIdx] - Clip[VertexIdx]) * t;
+			InPosition[InCount] = Position[VertexIdx] + (Position[NextIdx] - Position[VertexIdx]) * t;
+			InNormal[InCount] = Normal[VertexIdx] + (Normal[NextIdx] - Normal[VertexIdx]) * t;
+			InCount++;
+		}
+	}
+
+	for (int FanIdx = 1; FanIdx + 1 < InCount; FanIdx++)
+	{
+		lcSoftwarePrimitive Primitive;
+
+		Primitive.Vertices[0] = ToScreen(InClip[0], InPosition[0], InNormal[0]);
+		Primitive.Vertices[1] = ToScreen(InClip[FanIdx], InPosition[FanIdx], InNormal[FanIdx]);
+		Primitive.Vertices[2] = ToScreen(InClip[FanIdx + 1], InPosition[FanIdx + 1], InNormal[FanIdx + 1]);
+
+		const lcSoftwareVertex& v0 = Primitive.Vertices[0];
+		const lcSoftwareVertex& v1 = Primitive.Vertices[1];
+		const lcSoftwareVertex& v2 = Primitive.Vertices[2];
+
+		const float Area = lcEdgeFunction(v0.x, v0.y, v1.x, v1.y, v2.x, v2.y);
+
+		if (Area == 0.0f || !std::isfinite(Area))
+			continue;
+
+		if (Area < 0.0f)
+			std::swap(Primitive.Vertices[1], Primitive.Vertices[2]);
+
+		const float ScreenArea = fabsf(Area);
+
+		// Equivalent of glPolygonOffset(Factor, 0.1) for a 24 bit depth buffer.
+		const float DzDx = ((v1.z - v0.z) * (v2.y - v0.y) - (v2.z - v0.z) * (v1.y - v0.y)) / ScreenArea;
+		const float DzDy = ((v1.x - v0.x) * (v2.z - v0.z) - (v2.x - v0.x) * (v1.z - v0.z)) / ScreenArea;
+
+		Primitive.DepthBias = DepthFactor > 0.0f ? DepthFactor * qMax(fabsf(DzDx), fabsf(DzDy)) + 0.1f / 16777216.0f : 0.0f;
+		Primitive.Color = Color;
+		Primitive.Line = false;
+		Primitive.Lit = Lit;
+		Primitive.Blend = Blend;
+		Primitive.MinX = qMax(static_cast<int>(floorf(qMin(v0.x, qMin(v1.x, v2.x)))), 0);
+		Primitive.MinY = qMax(static_cast<int>(floorf(qMin(v0.y, qMin(v1.y, v2.y)))), 0);
+		Primitive.MaxX = qMin(static_cast<int>(ceilf(qMax(v0.x, qMax(v1.x, v2.x)))), mWidth - 1);
+		Primitive.MaxY = qMin(static_cast<int>(ceilf(qMax(v0.y, qMax(v1.y, v2.y)))), mHeight - 1);
+
+		if (Primitive.MinX > Primitive.MaxX || Primitive.MinY > Primitive.MaxY)
+			continue;
+
+		mPrimitives.emplace_back(Primitive);
+	}
+}
+
+void lcSoftwareRenderer::AddLine(const lcVector4& Clip1, const lcVector4& Clip2, const lcVector4& Color)
+{
+	lcVector4 Start = Clip1, End = Clip2;
+	const float StartDistance = Start.z + Start.w;
+	const float EndDistance = End.z + End.w;
+
+	if (StartDistance < 0.0f && EndDistance < 0.0f)
+		return;
+
+	if (StartDistance < 0.0f)
+		Start = Start + (End - Start) * (StartDistance / (StartDistance - EndDistance));
+	else if (EndDistance < 0.0f)
+		End = End + (Start - End) * (EndDistance / (EndDistance - StartDistance));
+
+	if (Start.w <= 0.0f || End.w <= 0.0f)
+		return;
+
+	lcSoftwarePrimitive Primitive;
+	const lcVector3 Zero(0.0f, 0.0f, 0.0f);
+
+	Primitive.Vertices[0] = ToScreen(Start, Zero, Zero);
+	Primitive.Vertices[1] = ToScreen(End, Zero, Zero);
+
+	const lcSoftwareVertex& v0 = Primitive.Vertices[0];
+	const lcSoftwareVertex& v1 = Primitive.Vertices[1];
+
+	if ((v0.x == v1.x && v0.y == v1.y) || !std::isfinite(v0.x + v0.y + v1.x + v1.y))
+		return;
+
+	const float HalfWidth = mLineWidth * 0.5f;
+
+	Primitive.DepthBias = 0.0f;
+	Primitive.Color = Color;
+	Primitive.Line = true;
+	Primitive.Lit = false;
+	Primitive.Blend = false;
+	Primitive.MinX = qMax(static_cast<int>(floorf(qMin(v0.x, v1.x) - HalfWidth)), 0);
+	Primitive.MinY = qMax(static_cast<int>(floorf(qMin(v0.y, v1.y) - HalfWidth)), 0);
+	Primitive.MaxX = qMin(static_cast<int>(ceilf(qMax(v0.x, v1.x) + HalfWidth)), mWidth - 1);
+	Primitive.MaxY = qMin(static_cast<int>(ceilf(qMax(v0.y, v1.y) + HalfWidth)), mHeight - 1);
+
+	if (Primitive.MinX > Primitive.MaxX || Primitive.MinY > Primitive.MaxY)
+		return;
+
+	mPrimitives.emplace_back(Primitive);
+}
+
+void lcSoftwareRenderer::BinPrimitives()
+{
+	const int TileColumns = (mWidth + TileSize - 1) / TileSize;
+	const int TileRows = (mHeight + TileSize - 1) / TileSize;
+
+	mTiles.clear();
+	mTiles.resize(static_cast<size_t>(TileColumns) * TileRows);
+
+	for (int Row = 0; Row < TileRows; Row++)
+	{
+		for (int Column = 0; Column < TileColumns; Column++)
+		{
+			lcSoftwareTile& Tile = mTiles[Row * TileColumns + Column];
+
+			Tile.x = Column * TileSize;
+			Tile.y = Row * TileSize;
+			Tile.Width = qMin(TileSize, mWidth - Tile.x);
+			Tile.Height = qMin(TileSize, mHeight - Tile.y);
+		}
+	}
+
+	// Binning in submission order keeps the per tile draw order identical to the OpenGL passes.
+	for (int PrimitiveIdx = 0; PrimitiveIdx < static_cast<int>(mPrimitives.size()); PrimitiveIdx++)
+	{
+		const lcSoftwarePrimitive& Primitive = mPrimitives[PrimitiveIdx];
+
+		for (int Row = Primitive.MinY / TileSize; Row <= Primitive.MaxY / TileSize; Row++)
+			for (int Column = Primitive.MinX / TileSize; Column <= Primitive.MaxX / TileSize; Column++)
+				mTiles[Row * TileColumns + Column].Primitives.push_back(PrimitiveIdx);
+	}
+}
+
+void lcSoftwareRenderer::RasterizeTile(lcSoftwareTile& Tile)
+{
+	for (const int PrimitiveIdx : Tile.Primitives)
+	{
+		const lcSoftwarePrimitive& Primitive = mPrimitives[PrimitiveIdx];
+
+		if (Primitive.Line)
+			RasterizeLine(Primitive, Tile);
+		else
+			RasterizeTriangle(Primitive, Tile);
+	}
+
+	Tile.Primitives.clear();
+	Tile.Primitives.shrink_to_fit();
+}
+
+void lcSoftwareRenderer::RasterizeTriangle(const lcSoftwarePrimitive& Primitive, const lcSoftwareTile& Tile)
+{
+	const lcSoftwareVertex& v0 = Primitive.Vertices[0];
+	const lcSoftwareVertex& v1 = Primitive.Vertices[1];
+	const lcSoftwareVertex& v2 = Primitive.Vertices[2];
+
+	const int MinX = qMax(Primitive.MinX, Tile.x);
+	const int MinY = qMax(Primitive.MinY, Tile.y);
+	const int MaxX = qMin(Primitive.MaxX, Tile.x + Tile.Width - 1);
+	const int MaxY = qMin(Primitive.MaxY, Tile.y + Tile.Height - 1);
+
+	const float Area = lcEdgeFunction(v0.x, v0.y, v1.x, v1.y, v2.x, v2.y);
+	const float InvArea = 1.0f / Area;
+
+	const bool TopLeft0 = lcIsTopLeftEdge(v1.x, v1.y, v2.x, v2.y);
+	const bool TopLeft1 = lcIsTopLeftEdge(v2.x, v2.y, v0.x, v0.y);
+	const bool TopLeft2 = lcIsTopLeftEdge(v0.x, v0.y, v1.x, v1.y);
+
+	for (int y = MinY; y <= MaxY; y++)
+	{
+		const float py = y + 0.5f;
+
+		for (int x = MinX; x <= MaxX; x++)
+		{
+			const float px = x + 0.5f;
+
+			const float w0 = lcEdgeFunction(v1.x, v1.y, v2.x, v2.y, px, py);
+			const float w1 = lcEdgeFunction(v2.x, v2.y, v0.x, v0.y, px, py);
+			const float w2 = lcEdgeFunction(v0.x, v0.y, v1.x, v1.y, px, py);
+
+			if (w0 < 0.0f || w1 < 0.0f || w2 < 0.0f)
+				continue;
+
+			if ((w0 == 0.0f && !TopLeft0) || (w1 == 0.0f && !TopLeft1) || (w2 == 0.0f && !TopLeft2))
+				continue;
+
+			const float b0 = w0 * InvArea;
+			const float b1 = w1 * InvArea;
+			const float b2 = w2 * InvArea;
+
+			const float Depth = b0 * v0.z + b1 * v1.z + b2 * v2.z + Primitive.DepthBias;
+
+			if (Depth < 0.0f || Depth > 1.0f)
+				continue;
+
+			const int Offset = y * mWidth + x;
+
+			if (Depth > mDepthBuffer[Offset])
+				continue;
+
+			lcVector4 Color;
+
+			if (Primitive.Lit)
+			{
+				const float p0 = b0 * v0.InvW;
+				const float p1 = b1 * v1.InvW;
+				const float p2 = b2 * v2.InvW;
+				const float InvSum = 1.0f / (p0 + p1 + p2);
+
+				const lcVector3 Position = (v0.Position * p0 + v1.Position * p1 + v2.Position * p2) * InvSum;
+				const lcVector3 Normal = (v0.Normal * p0 + v1.Normal * p1 + v2.Normal * p2) * InvSum;
+
+				Color = ShadePixel(Primitive, Position, Normal);
+			}
+			else
+				Color = Primitive.Color;
+
+			WritePixel(Offset, Depth, Color, Primitive.Blend);
+		}
+	}
+}
+
+void lcSoftwareRenderer::RasterizeLine(const lcSoftwarePrimitive& Primitive, const lcSoftwareTile& Tile)
+{
+	const lcSoftwareVertex& v0 = Primitive.Vertices[0];
+	const lcSoftwareVertex& v1 = Primitive.Vertices[1];
+
+	const int MinX = qMax(Primitive.MinX, Tile.x);
+	const int MinY = qMax(Primitive.MinY, Tile.y);
+	const int MaxX = qMin(Primitive.MaxX, Tile.x + Tile.Width - 1);
+	const int MaxY = qMin(Primitive.MaxY, Tile.y + Tile.Height - 1);
+
+	const float dx = v1.x - v0.x;
+	const float dy = v1.y - v0.y;
+	const bool XMajor = fabsf(dx) >= fabsf(dy);
+	const float HalfWidth = mLineWidth * 0.5f;
+
+	// Wide lines are measured along the minor axis like non antialiased OpenGL lines.
+	for (int y = MinY; y <= MaxY; y++)
+	{
+		const float py = y + 0.5f;
+
+		for (int x = MinX; x <= MaxX; x++)
+		{
+			const float px = x + 0.5f;
+			float t, Distance;
+
+			if (XMajor)
+			{
+				t = (px - v0.x) / dx;
+				Distance = py - (v0.y + t * dy);
+			}
+			else
+			{
+				t = (py - v0.y) / dy;
+				Distance = px - (v0.x + t * dx);
+			}
+
+			if (t < 0.0f || t >= 1.0f || Distance < -HalfWidth || Distance >= HalfWidth)
+				continue;
+
+			const float Depth = v0.z + (v1.z - v0.z) * t;
+
+			if (Depth < 0.0f || Depth > 1.0f)
+				continue;
+
+			const int Offset = y * mWidth + x;
+
+			if (Depth > mDepthBuffer[Offset])
+				continue;
+
+			WritePixel(Offset, Depth, Primitive.Color, false);
+		}
+	}
+}
+
+void lcSoftwareRenderer::WritePixel(int Offset, float Depth, const lcVector4& Color, bool Blend)
+{
+	lcVector4& Destination = mColorBuffer[Offset];
+
+	if (!Blend)
+	{
+		Destination = Color;
+		mDepthBuffer[Offset] = Depth;
+		return;
+	}
+
+	// glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE_MINUS_DST_ALPHA, GL_ONE) without depth writes.
+	const float Alpha = Color.w;
+	const float DestinationAlpha = Destination.w;
+
+	Destination.x = Color.x * Alpha + Destination.x * (1.0f - Alpha);
+	Destination.y = Color.y * Alpha + Destination.y * (1.0f - Alpha);
+	Destination.z = Color.z * Alpha + Destination.z * (1.0f - Alpha);
+	Destination.w = Alpha * (1.0f - DestinationAlpha) + DestinationAlpha;
+}
+
+lcVector4 lcSoftwareRenderer::ShadePixel(const lcSoftwarePrimitive& Primitive, const lcVector3& Position, const lcVector3& Normal) const
+{
+	// Same as LC_PIXEL_FAKE_LIGHTING in lc_context.cpp.
+	const float NormalLength = lcLength(Normal);
+
+	if (NormalLength == 0.0f)
+		return Primitive.Color;
+
+	const lcVector3 PixelNormal = Normal / NormalLength;
+	const lcVector3 LightDirection = lcNormalize(Position - mLightPosition);
+	const lcVector3 VertexToEye = lcNormalize(mEyePosition - Position);
+	const lcVector3 Incident = -LightDirection;
+	const lcVector3 LightReflect = lcNormalize(Incident - PixelNormal * (2.0f * lcDot(PixelNormal, Incident)));
+
+	const float Specular = qMin(powf(fabsf(lcDot(VertexToEye, LightReflect)), 8.0f), 1.0f) * 0.25f;
+	const float Diffuse = qMin(fabsf(lcDot(PixelNormal, LightDirection)) * 0.6f + 0.65f, 1.0f);
+
+	return lcVector4(lcVector3(Primitive.Color) * Diffuse + lcVector3(Specular, Specular, Specular), Primitive.Color.w);
+}
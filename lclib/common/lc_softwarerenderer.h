@@ -0,0 +1,94 @@
+#pragma once
+
+#include "lc_math.h"
+
+class lcScene;
+struct lcRenderMesh;
+struct lcMeshSection;
+
+// CPU rasterizer for lcScene, used by offscreen renders when no usable OpenGL framebuffer is available.
+// The image is split into fixed size tiles, primitives are binned per tile in submission order and
+// the tiles are rasterized in parallel so each worker owns its color and depth pixels exclusively.
+class lcSoftwareRenderer
+{
+public:
+	lcSoftwareRenderer(int Width, int Height);
+
+	lcSoftwareRenderer(const lcSoftwareRenderer&) = delete;
+	lcSoftwareRenderer& operator=(const lcSoftwareRenderer&) = delete;
+
+	void SetLineWidth(float LineWidth)
+	{
+		mLineWidth = qMax(LineWidth, 1.0f);
+	}
+
+	void SetBackgroundColor(const lcVector4& BackgroundColor)
+	{
+		mBackgroundColor = BackgroundColor;
+	}
+
+	bool Render(const lcScene* Scene, const lcMatrix44& ProjectionMatrix, QImage& Image);
+
+	static constexpr int TileSize = 64;
+
+protected:
+	struct lcSoftwareVertex
+	{
+		float x, y, z;
+		float InvW;
+		lcVector3 Position;
+		lcVector3 Normal;
+	};
+
+	struct lcSoftwarePrimitive
+	{
+		lcSoftwareVertex Vertices[3];
+		lcVector4 Color;
+		float DepthBias;
+		bool Line;
+		bool Lit;
+		bool Blend;
+		int MinX, MinY, MaxX, MaxY;
+	};
+
+	struct lcSoftwareTile
+	{
+		int x, y;
+		int Width, Height;
+		std::vector<int> Primitives;
+	};
+
+	enum lcSoftwarePrimitiveTypes
+	{
+		LC_SOFTWARE_TRIANGLES = 0x01,
+		LC_SOFTWARE_LINES = 0x02,
+		LC_SOFTWARE_CONDITIONAL_LINES = 0x04
+	};
+
+	void AddOpaqueMeshes(const lcScene* Scene, bool DrawLit, int PrimitiveTypes, bool DrawFaded, bool DrawNonFaded);
+	void AddTranslucentMeshes(const lcScene* Scene, bool DrawLit, bool DrawFaded, bool DrawNonFaded);
+	void AddSection(const lcRenderMesh& RenderMesh, const lcMeshSection* Section, const lcVector4& Color, bool Lit, bool Blend, float DepthFactor);
+	void AddTriangle(const lcVector4 (&Clip)[3], const lcVector3 (&Position)[3], const lcVector3 (&Normal)[3], const lcVector4& Color, bool Lit, bool Blend, float DepthFactor);
+	void AddLine(const lcVector4& Clip1, const lcVector4& Clip2, const lcVector4& Color);
+	lcSoftwareVertex ToScreen(const lcVector4& Clip, const lcVector3& Position, const lcVector3& Normal) const;
+
+	void BinPrimitives();
+	void RasterizeTile(lcSoftwareTile& Tile);
+	void RasterizeTriangle(const lcSoftwarePrimitive& Primitive, const lcSoftwareTile& Tile);
+	void RasterizeLine(const lcSoftwarePrimitive& Primitive, const lcSoftwareTile& Tile);
+	void WritePixel(int Offset, float Depth, const lcVector4& Color, bool Blend);
+	lcVector4 ShadePixel(const lcSoftwarePrimitive& Primitive, const lcVector3& Position, const lcVector3& Normal) const;
+
+	int mWidth;
+	int mHeight;
+	float mLineWidth;
+	lcVector4 mBackgroundColor;
+	lcMatrix44 mViewProjectionMatrix;
+	lcVector3 mEyePosition;
+	lcVector3 mLightPosition;
+
+	std::vector<lcSoftwarePrimitive> mPrimitives;
+	std::vector<lcSoftwareTile> mTiles;
+	std::vector<lcVector4> mColorBuffer;
+	std::vector<float> mDepthBuffer;
+};
@@ -4,9 +4,84 @@
 #include "lc_library.h"
 #include "image.h"
 #include "lc_glextensions.h"
+/*** LPub3D Mod - texture load pipeline ***/
+#include "lpub_preferences.h"
+
+#define LC_TEXTURE_CACHE_MAGIC   0x5854434c // 'LCTX'
+#define LC_TEXTURE_CACHE_VERSION 1
+/*** LPub3D Mod end ***/
 
 lcTexture* gGridTexture;
 
+/*** LPub3D Mod - texture load pipeline ***/
+// Decoded power of two images are cached next to the mesh cache, named by the checksum of the source file.
+static QString lcGetTextureCacheFileName(const QByteArray& Data)
+{
+	if (Preferences::lpub3dCachePath.isEmpty())
+		return QString();
+
+	const QString Hash = QString::fromLatin1(QCryptographicHash::hash(Data, QCryptographicHash::Sha1).toHex());
+
+	return QString("%1/textures/%2/%3.bin").arg(Preferences::lpub3dCachePath, Hash.left(2), Hash);
+}
+
+static bool lcLoadTextureCache(const QString& FileName, Image& Image)
+{
+	QFile File(FileName);
+
+	if (FileName.isEmpty() || !File.open(QIODevice::ReadOnly))
+		return false;
+
+	quint32 Header[5];
+
+	if (File.read((char*)Header, sizeof(Header)) != sizeof(Header) || Header[0] != LC_TEXTURE_CACHE_MAGIC || Header[1] != LC_TEXTURE_CACHE_VERSION)
+		return false;
+
+	const lcPixelFormat Format = static_cast<lcPixelFormat>(Header[4]);
+
+	if (Format != lcPixelFormat::R8G8B8 && Format != lcPixelFormat::R8G8B8A8)
+		return false;
+
+	// Validate the header against the file size before allocating, Image::Allocate sizes the buffer in int
+	const quint32 MaxSize = 32768;
+
+	if (!Header[2] || !Header[3] || Header[2] > MaxSize || Header[3] > MaxSize)
+		return false;
+
+	const qint64 BPP = Format == lcPixelFormat::R8G8B8A8 ? 4 : 3;
+	const qint64 DataSize = (qint64)Header[2] * Header[3] * BPP;
+
+	if (DataSize > INT_MAX || File.size() != (qint64)sizeof(Header) + DataSize)
+		return false;
+
+	Image.Allocate(Header[2], Header[3], Format);
+
+	if (!Image.mData || File.read((char*)Image.mData, DataSize) != DataSize)
+	{
+		Image.FreeData();
+		return false;
+	}
+
+	return true;
+}
+
+static void lcSaveTextureCache(const QString& FileName, const Image& Image)
+{
+	if (FileName.isEmpty() || !Image.mData || !QDir().mkpath(QFileInfo(FileName).absolutePath()))
+		return;
+
+	const quint32 Header[5] = { LC_TEXTURE_CACHE_MAGIC, LC_TEXTURE_CACHE_VERSION, (quint32)Image.mWidth, (quint32)Image.mHeight, static_cast<quint32>(Image.mFormat) };
+	QSaveFile File(FileName);
+
+	if (!File.open(QIODevice::WriteOnly))
+		return;
+
+	File.write((const char*)Header, sizeof(Header));
+	File.write((const char*)Image.mData, (qint64)Image.mWidth * Image.mHeight * Image.GetBPP());
+	File.commit();
+}
+/*** LPub3D Mod end ***/
+
 lcTexture* lcLoadTexture(const QString& FileName, int Flags)
 {
 	lcTexture* Texture = new lcTexture();
@@ -174,29 +249,50 @@ bool lcTexture::Load()
 	return lcGetPiecesLibrary()->LoadTexture(this);
 }
 
-bool lcTexture::Load(const QString& FileName, int Flags)
+/*** LPub3D Mod - texture load pipeline ***/
+// Decode and resize on a worker thread, the main thread only uploads the result when the texture is drawn.
+void lcTexture::LoadAsync()
+{
+	mLoadFuture.waitForFinished();
+	mLoadFuture = QtConcurrent::run([this]() { return Load(); });
+}
+
+bool lcTexture::LoadData(const QByteArray& Data, int Flags)
 {
+	const QString CacheFileName = lcGetTextureCacheFileName(Data);
 	Image Image;
 
-	if (!Image.FileLoad(FileName))
-		return false;
+	if (!lcLoadTextureCache(CacheFileName, Image))
+	{
+		if (!Image.FileLoad(Data))
+			return false;
+
+		Image.ResizePow2();
+		lcSaveTextureCache(CacheFileName, Image);
+	}
 
 	SetImage(std::move(Image), Flags);
 
 	return true;
 }
 
-bool lcTexture::Load(lcMemFile& File, int Flags)
+bool lcTexture::Load(const QString& FileName, int Flags)
 {
-	Image Image;
+	QFile File(FileName);
 
-	if (!Image.FileLoad(File))
+	if (!File.open(QIODevice::ReadOnly))
 		return false;
 
-	SetImage(std::move(Image), Flags);
+	return LoadData(File.readAll(), Flags);
+}
 
-	return true;
+bool lcTexture::Load(lcMemFile& File, int Flags)
+{
+	const QByteArray Data = QByteArray::fromRawData((const char*)File.mBuffer + File.mPosition, (int)(File.mFileSize - File.mPosition));
+
+	return LoadData(Data, Flags);
 }
+/*** LPub3D Mod end ***/
 
 void lcTexture::SetImage(Image&& Image, int Flags)
 {
@@ -217,6 +313,10 @@ void lcTexture::SetImage(std::vector<Image>&& Images, int Flags)
 
 void lcTexture::Upload(lcContext* Context)
 {
+/*** LPub3D Mod - texture load pipeline ***/
+	mLoadFuture.waitForFinished();
+/*** LPub3D Mod end ***/
+
 	if (!NeedsUpload())
 		return;
 
@@ -233,7 +333,9 @@ bool lcTexture::LoadImages()
 	for (Image& Image : mImages)
 		Image.ResizePow2();
 
-	if (QThread::currentThread() == qApp->thread())
+/*** LPub3D Mod - native software renderer ***/
+	if (QThread::currentThread() == qApp->thread() && lcContext::HasOffscreenContext())
+/*** LPub3D Mod end ***/
 	{
 		lcContext* Context = lcContext::GetGlobalOffscreenContext();
 		Context->MakeCurrent();
@@ -245,6 +347,10 @@ bool lcTexture::LoadImages()
 
 void lcTexture::Unload()
 {
+/*** LPub3D Mod - texture load pipeline ***/
+	mLoadFuture.waitForFinished();
+/*** LPub3D Mod end ***/
+
 	if (mTexture)
 		glDeleteTextures(1, &mTexture);
 	mTexture = 0;
@@ -46,7 +46,9 @@ public:
 		mRefCount.ref();
 
 		if (mRefCount == 1)
-			Load();
+/*** LPub3D Mod - texture load pipeline ***/
+			LoadAsync();
+/*** LPub3D Mod end ***/
 	}
 
 	bool Release()
@@ -71,7 +73,9 @@ public:
 
 	bool NeedsUpload() const
 	{
-		return mTexture == 0 && !mImages.empty();
+/*** LPub3D Mod - texture load pipeline ***/
+		return mTexture == 0 && (!mLoadFuture.isFinished() || !mImages.empty());
+/*** LPub3D Mod end ***/
 	}
 
 	int GetFlags() const
@@ -101,6 +105,12 @@ public:
 protected:
 	bool Load();
 	bool LoadImages();
+/*** LPub3D Mod - texture load pipeline ***/
+	void LoadAsync();
+	bool LoadData(const QByteArray& Data, int Flags);
+
+	QFuture<bool> mLoadFuture;
+/*** LPub3D Mod end ***/
 
 	bool mTemporary;
 	QAtomicInt mRefCount;
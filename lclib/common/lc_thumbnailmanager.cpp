@@ -5,25 +5,53 @@
 #include "lc_view.h"
 #include "lc_model.h"
 #include "camera.h"
+/*** LPub3D Mod - thumbnail cache ***/
+#include "lc_colors.h"
+#include "lc_application.h"
+#include "lpub_preferences.h"
+
+#define LC_THUMBNAIL_CACHE_VERSION 2
+#define LC_THUMBNAIL_CACHE_MAX_SIZE (64 * 1024 * 1024)
+/*** LPub3D Mod end ***/
 
 lcThumbnailManager::lcThumbnailManager(lcPiecesLibrary* Library)
 	: QObject(Library), mLibrary(Library)
 {
 	connect(mLibrary, &lcPiecesLibrary::PartLoaded, this, &lcThumbnailManager::PartLoaded);
+
+/*** LPub3D Mod - thumbnail cache ***/
+	if (!Preferences::lpub3dCachePath.isEmpty())
+		mCachePath = QDir(Preferences::lpub3dCachePath).absoluteFilePath(QLatin1String("thumbnails"));
+
+	mCacheThreadPool.setMaxThreadCount(2);
+
+	PruneCache();
+/*** LPub3D Mod end ***/
 }
 
 lcThumbnailManager::~lcThumbnailManager()
 {
 	for (auto &[ThumbnailId, Thumbnail] : mThumbnails)
-		if (Thumbnail.Pixmap.isNull())
+/*** LPub3D Mod - thumbnail cache ***/
+		if (Thumbnail.PieceLoaded)
+/*** LPub3D Mod end ***/
 			mLibrary->ReleasePieceInfo(Thumbnail.Info);
 }
 
 std::pair<lcPartThumbnailId, QPixmap> lcThumbnailManager::RequestThumbnail(PieceInfo* Info, int ColorIndex, int Size)
 {
-	for (auto &[ThumbnailId, Thumbnail] : mThumbnails)
-		if (Thumbnail.Info == Info && Thumbnail.ColorIndex == ColorIndex && Thumbnail.Size == Size)
-			return { ThumbnailId, Thumbnail.Pixmap };
+/*** LPub3D Mod - thumbnail cache ***/
+	const lcPartThumbnailKey Key = { Info, ColorIndex, Size };
+	const auto IdIt = mThumbnailIds.find(Key);
+
+	if (IdIt != mThumbnailIds.end())
+	{
+		lcPartThumbnail& Thumbnail = mThumbnails[IdIt->second];
+		Thumbnail.ReferenceCount++;
+
+		return { IdIt->second, Thumbnail.Pixmap };
+	}
+/*** LPub3D Mod end ***/
 
 	lcPartThumbnailId ThumbnailId = static_cast<lcPartThumbnailId>(mNextThumbnailId++);
 	lcPartThumbnail& Thumbnail = mThumbnails[ThumbnailId];
@@ -33,10 +61,17 @@ std::pair<lcPartThumbnailId, QPixmap> lcThumbnailManager::RequestThumbnail(Piece
 	Thumbnail.Size = Size;
 	Thumbnail.ReferenceCount = 1;
 
-	mLibrary->LoadPieceInfo(Info, false, false);
+/*** LPub3D Mod - thumbnail cache ***/
+	Thumbnail.PieceLoaded = false;
+	Thumbnail.CacheFileName = GetCacheFileName(Thumbnail);
+
+	mThumbnailIds[Key] = ThumbnailId;
 
-	if (Info->mState == lcPieceInfoState::Loaded)
-		DrawThumbnail(ThumbnailId, Thumbnail);
+	if (!Thumbnail.CacheFileName.isEmpty() && QFileInfo::exists(Thumbnail.CacheFileName))
+		LoadCachedThumbnail(ThumbnailId, Thumbnail.CacheFileName);
+	else
+		LoadPieceInfo(ThumbnailId, Thumbnail);
+/*** LPub3D Mod end ***/
 
 	return { ThumbnailId, Thumbnail.Pixmap };
 }
@@ -54,24 +89,236 @@ void lcThumbnailManager::ReleaseThumbnail(lcPartThumbnailId ThumbnailId)
 
 	if (Thumbnail.ReferenceCount == 0)
 	{
-		if (Thumbnail.Pixmap.isNull())
+/*** LPub3D Mod - thumbnail cache ***/
+		if (Thumbnail.PieceLoaded)
 			mLibrary->ReleasePieceInfo(Thumbnail.Info);
 
+		mThumbnailIds.erase({ Thumbnail.Info, Thumbnail.ColorIndex, Thumbnail.Size });
+
+		const auto PendingRange = mPendingThumbnails.equal_range(Thumbnail.Info);
+
+		for (auto PendingIt = PendingRange.first; PendingIt != PendingRange.second; ++PendingIt)
+		{
+			if (PendingIt->second == ThumbnailId)
+			{
+				mPendingThumbnails.erase(PendingIt);
+				break;
+			}
+		}
+/*** LPub3D Mod end ***/
+
 		mThumbnails.erase(ThumbnailIt);
 	}
 }
 
 void lcThumbnailManager::PartLoaded(PieceInfo* Info)
 {
-	for (auto& [ThumbnailId, Thumbnail] : mThumbnails)
-		if (Thumbnail.Info == Info && Thumbnail.Pixmap.isNull())
-			DrawThumbnail(ThumbnailId, Thumbnail);
+/*** LPub3D Mod - thumbnail cache ***/
+	const auto PendingRange = mPendingThumbnails.equal_range(Info);
+
+	for (auto PendingIt = PendingRange.first; PendingIt != PendingRange.second; ++PendingIt)
+		QueueThumbnail(PendingIt->second);
+
+	mPendingThumbnails.erase(PendingRange.first, PendingRange.second);
+/*** LPub3D Mod end ***/
 }
 
-void lcThumbnailManager::DrawThumbnail(lcPartThumbnailId ThumbnailId, lcPartThumbnail& Thumbnail)
+/*** LPub3D Mod - thumbnail cache ***/
+// The cache file name hashes everything that changes the rendered image.
+QString lcThumbnailManager::GetCacheFileName(const lcPartThumbnail& Thumbnail) const
+{
+	if (mCachePath.isEmpty() || Thumbnail.ColorIndex < 0 || Thumbnail.ColorIndex >= static_cast<int>(gColorList.size()))
+		return QString();
+
+	const QByteArray FileStamp = mLibrary->GetPieceFileStamp(Thumbnail.Info);
+
+	if (FileStamp.isEmpty())
+		return QString();
+
+	const lcColor& Color = gColorList[Thumbnail.ColorIndex];
+	const lcPreferences& ViewPreferences = lcGetPreferences();
+	const QRgb BackgroundColor = QApplication::palette().color(QPalette::Base).rgba();
+	const QRgb TextColor = QApplication::palette().color(QPalette::WindowText).rgba();
+
+	const QStringList Key =
+	{
+		QString::number(LC_THUMBNAIL_CACHE_VERSION),
+		QString::fromLatin1(Thumbnail.Info->mFileName),
+		QString::fromLatin1(FileStamp),
+		QString::number(Color.Code),
+		QString("%1,%2,%3,%4").arg(Color.Value[0]).arg(Color.Value[1]).arg(Color.Value[2]).arg(Color.Value[3]),
+		QString("%1,%2,%3,%4").arg(Color.Edge[0]).arg(Color.Edge[1]).arg(Color.Edge[2]).arg(Color.Edge[3]),
+		QString::number(Thumbnail.Size),
+		QString::number(static_cast<int>(mLibrary->GetStudStyle())),
+		QString::number(mLibrary->IsStudCylinderColorEnabled() ? 1 : 0),
+		QString::number(BackgroundColor, 16),
+		QString::number(TextColor, 16),
+		QString("%1,%2,%3,%4").arg(static_cast<int>(ViewPreferences.mShadingMode)).arg(ViewPreferences.mDrawEdgeLines).arg(ViewPreferences.mDrawConditionalLines).arg(ViewPreferences.mLineWidth),
+		QString("%1,%2").arg(ViewPreferences.mAllowLOD).arg(ViewPreferences.mMeshLODDistance),
+		QString("%1,%2,%3").arg(ViewPreferences.mAutomateEdgeColor).arg(ViewPreferences.mPartEdgeContrast).arg(ViewPreferences.mPartColorValueLDIndex),
+		QString("%1,%2,%3,%4").arg(ViewPreferences.mStudCylinderColor, 0, 16).arg(ViewPreferences.mPartEdgeColorEnabled).arg(ViewPreferences.mPartEdgeColor, 0, 16).arg(ViewPreferences.mBlackEdgeColorEnabled),
+		QString("%1,%2,%3").arg(ViewPreferences.mBlackEdgeColor, 0, 16).arg(ViewPreferences.mDarkEdgeColorEnabled).arg(ViewPreferences.mDarkEdgeColor, 0, 16)
+	};
+
+	const QString Hash = QString::fromLatin1(QCryptographicHash::hash(Key.join(QLatin1Char('|')).toUtf8(), QCryptographicHash::Sha1).toHex());
+
+	return QString("%1/%2/%3.png").arg(mCachePath, Hash.left(2), Hash);
+}
+
+void lcThumbnailManager::LoadCachedThumbnail(lcPartThumbnailId ThumbnailId, const QString& FileName)
+{
+	QFutureWatcher<QImage>* Watcher = new QFutureWatcher<QImage>(this);
+
+	connect(Watcher, &QFutureWatcher<QImage>::finished, this, [this, Watcher, ThumbnailId]()
+	{
+		CachedThumbnailLoaded(ThumbnailId, Watcher->result());
+		Watcher->deleteLater();
+	});
+
+	Watcher->setFuture(QtConcurrent::run(&mCacheThreadPool, [FileName]()
+	{
+		return QImage(FileName);
+	}));
+}
+
+void lcThumbnailManager::CachedThumbnailLoaded(lcPartThumbnailId ThumbnailId, const QImage& Image)
 {
-	const int Width = Thumbnail.Size * 2;
-	const int Height = Thumbnail.Size * 2;
+	auto ThumbnailIt = mThumbnails.find(ThumbnailId);
+
+	if (ThumbnailIt == mThumbnails.end())
+		return;
+
+	lcPartThumbnail& Thumbnail = ThumbnailIt->second;
+
+	if (!Thumbnail.Pixmap.isNull() || Thumbnail.PieceLoaded)
+		return;
+
+	if (Image.isNull() || Image.width() != Thumbnail.Size || Image.height() != Thumbnail.Size)
+	{
+		LoadPieceInfo(ThumbnailId, Thumbnail);
+		return;
+	}
+
+	Thumbnail.Pixmap = QPixmap::fromImage(Image);
+
+	emit ThumbnailReady(ThumbnailId, Thumbnail.Pixmap);
+}
+
+void lcThumbnailManager::SaveCachedThumbnail(const QString& FileName, const QImage& Image)
+{
+	QtConcurrent::run(&mCacheThreadPool, [FileName, Image]()
+	{
+		if (!QDir().mkpath(QFileInfo(FileName).absolutePath()))
+			return;
+
+		QSaveFile File(FileName);
+
+		if (File.open(QIODevice::WriteOnly) && Image.save(&File, "PNG"))
+			File.commit();
+	});
+}
+
+// Remove the oldest cached thumbnails once the cache grows past its size cap.
+void lcThumbnailManager::PruneCache()
+{
+	if (mCachePath.isEmpty())
+		return;
+
+	const QString CachePath = mCachePath;
+
+	QtConcurrent::run(&mCacheThreadPool, [CachePath]()
+	{
+		QFileInfoList Files;
+		qint64 CacheSize = 0;
+
+		QDirIterator FileIt(CachePath, QStringList() << QLatin1String("*.png"), QDir::Files, QDirIterator::Subdirectories);
+
+		while (FileIt.hasNext())
+		{
+			FileIt.next();
+			Files.append(FileIt.fileInfo());
+			CacheSize += Files.last().size();
+		}
+
+		if (CacheSize <= LC_THUMBNAIL_CACHE_MAX_SIZE)
+			return;
+
+		std::sort(Files.begin(), Files.end(), [](const QFileInfo& a, const QFileInfo& b)
+		{
+			return a.lastModified() < b.lastModified();
+		});
+
+		for (const QFileInfo& File : Files)
+		{
+			if (CacheSize <= LC_THUMBNAIL_CACHE_MAX_SIZE * 3 / 4)
+				break;
+
+			if (QFile::remove(File.absoluteFilePath()))
+				CacheSize -= File.size();
+		}
+	});
+}
+
+void lcThumbnailManager::LoadPieceInfo(lcPartThumbnailId ThumbnailId, lcPartThumbnail& Thumbnail)
+{
+	Thumbnail.PieceLoaded = true;
+
+	mLibrary->LoadPieceInfo(Thumbnail.Info, false, false);
+
+	if (Thumbnail.Info->mState == lcPieceInfoState::Loaded)
+		QueueThumbnail(ThumbnailId);
+	else
+		mPendingThumbnails.emplace(Thumbnail.Info, ThumbnailId);
+}
+
+// Thumbnails are drawn together once control returns to the event loop.
+void lcThumbnailManager::QueueThumbnail(lcPartThumbnailId ThumbnailId)
+{
+	if (mDrawQueue.empty())
+		QTimer::singleShot(0, this, &lcThumbnailManager::DrawQueuedThumbnails);
+
+	mDrawQueue.push_back(ThumbnailId);
+}
+
+void lcThumbnailManager::DrawQueuedThumbnails()
+{
+	std::vector<std::pair<int, lcPartThumbnailId>> DrawQueue;
+
+	for (lcPartThumbnailId ThumbnailId : mDrawQueue)
+	{
+		const auto ThumbnailIt = mThumbnails.find(ThumbnailId);
+
+		if (ThumbnailIt != mThumbnails.end() && ThumbnailIt->second.Pixmap.isNull() && ThumbnailIt->second.PieceLoaded)
+			DrawQueue.emplace_back(ThumbnailIt->second.Size, ThumbnailId);
+	}
+
+	mDrawQueue.clear();
+
+	std::sort(DrawQueue.begin(), DrawQueue.end());
+
+	int DrawSize = 0;
+	bool DrawReady = false;
+
+	for (const auto& [Size, ThumbnailId] : DrawQueue)
+	{
+		if (Size != DrawSize)
+		{
+			DrawSize = Size;
+			DrawReady = BeginDrawThumbnails(Size);
+		}
+
+		const auto ThumbnailIt = mThumbnails.find(ThumbnailId);
+
+		if (DrawReady && ThumbnailIt != mThumbnails.end() && ThumbnailIt->second.Pixmap.isNull())
+			DrawThumbnail(ThumbnailId, ThumbnailIt->second);
+	}
+}
+
+// Prepare the offscreen view once for a batch of thumbnails of the same size.
+bool lcThumbnailManager::BeginDrawThumbnails(int Size)
+{
+	const int Width = Size * 2;
+	const int Height = Size * 2;
 
 	if (mView && (mView->GetWidth() != Width || mView->GetHeight() != Height))
 		mView.reset();
@@ -89,16 +336,25 @@ void lcThumbnailManager::DrawThumbnail(lcPartThumbnailId ThumbnailId, lcPartThum
 		if (!mView->BeginRenderToImage(Width, Height))
 		{
 			mView.reset();
-			return;
+			return false;
 		}
 	}
 
 	mView->MakeCurrent();
-	mView->BindRenderFramebuffer();
 
 	const uint BackgroundColor = QApplication::palette().color(QPalette::Base).rgba();
 	mView->SetBackgroundColorOverride(LC_RGBA(qRed(BackgroundColor), qGreen(BackgroundColor), qBlue(BackgroundColor), 0));
 
+	return true;
+}
+/*** LPub3D Mod end ***/
+
+void lcThumbnailManager::DrawThumbnail(lcPartThumbnailId ThumbnailId, lcPartThumbnail& Thumbnail)
+{
+/*** LPub3D Mod - thumbnail cache ***/
+	mView->BindRenderFramebuffer();
+/*** LPub3D Mod end ***/
+
 	PieceInfo* Info = Thumbnail.Info;
 	mModel->SetPreviewPieceInfo(Info, Thumbnail.ColorIndex);
 
@@ -146,9 +402,17 @@ void lcThumbnailManager::DrawThumbnail(lcPartThumbnailId ThumbnailId, lcPartThum
 		Painter.end();
 	}
 
-	Thumbnail.Pixmap = QPixmap::fromImage(Image).scaled(Thumbnail.Size, Thumbnail.Size, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+/*** LPub3D Mod - thumbnail cache ***/
+	const QImage ThumbnailImage = Image.scaled(Thumbnail.Size, Thumbnail.Size, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+
+	Thumbnail.Pixmap = QPixmap::fromImage(ThumbnailImage);
 
 	mLibrary->ReleasePieceInfo(Info);
+	Thumbnail.PieceLoaded = false;
+
+	if (!Thumbnail.CacheFileName.isEmpty())
+		SaveCachedThumbnail(Thumbnail.CacheFileName, ThumbnailImage);
+/*** LPub3D Mod end ***/
 
 	emit ThumbnailReady(ThumbnailId, Thumbnail.Pixmap);
 }
@@ -1,5 +1,9 @@
 #pragma once
 
+/*** LPub3D Mod - thumbnail cache ***/
+#include <unordered_map>
+/*** LPub3D Mod end ***/
+
 class lcPiecesLibrary;
 
 struct lcPartThumbnail
@@ -9,6 +13,10 @@ struct lcPartThumbnail
 	int ColorIndex;
 	int Size;
 	int ReferenceCount;
+/*** LPub3D Mod - thumbnail cache ***/
+	bool PieceLoaded;
+	QString CacheFileName;
+/*** LPub3D Mod end ***/
 };
 
 enum class lcPartThumbnailId : uint64_t
@@ -16,6 +24,31 @@ enum class lcPartThumbnailId : uint64_t
 	Invalid = 0
 };
 
+/*** LPub3D Mod - thumbnail cache ***/
+struct lcPartThumbnailKey
+{
+	PieceInfo* Info;
+	int ColorIndex;
+	int Size;
+
+	bool operator==(const lcPartThumbnailKey& Other) const
+	{
+		return Info == Other.Info && ColorIndex == Other.ColorIndex && Size == Other.Size;
+	}
+};
+
+struct lcPartThumbnailKeyHash
+{
+	size_t operator()(const lcPartThumbnailKey& Key) const
+	{
+		size_t Hash = std::hash<PieceInfo*>()(Key.Info);
+		Hash ^= std::hash<int>()(Key.ColorIndex) + 0x9e3779b9 + (Hash << 6) + (Hash >> 2);
+		Hash ^= std::hash<int>()(Key.Size) + 0x9e3779b9 + (Hash << 6) + (Hash >> 2);
+		return Hash;
+	}
+};
+/*** LPub3D Mod end ***/
+
 class lcThumbnailManager : public QObject
 {
 	Q_OBJECT
@@ -32,9 +65,22 @@ signals:
 
 protected slots:
 	void PartLoaded(PieceInfo* Info);
+/*** LPub3D Mod - thumbnail cache ***/
+	void DrawQueuedThumbnails();
+/*** LPub3D Mod end ***/
 
 protected:
 	void DrawThumbnail(lcPartThumbnailId ThumbnailId, lcPartThumbnail& Thumbnail);
+/*** LPub3D Mod - thumbnail cache ***/
+	QString GetCacheFileName(const lcPartThumbnail& Thumbnail) const;
+	void LoadCachedThumbnail(lcPartThumbnailId ThumbnailId, const QString& FileName);
+	void CachedThumbnailLoaded(lcPartThumbnailId ThumbnailId, const QImage& Image);
+	void SaveCachedThumbnail(const QString& FileName, const QImage& Image);
+	void PruneCache();
+	void LoadPieceInfo(lcPartThumbnailId ThumbnailId, lcPartThumbnail& Thumbnail);
+	void QueueThumbnail(lcPartThumbnailId ThumbnailId);
+	bool BeginDrawThumbnails(int Size);
+/*** LPub3D Mod end ***/
 
 	lcPiecesLibrary* mLibrary = nullptr;
 	std::map<lcPartThumbnailId, lcPartThumbnail> mThumbnails;
@@ -42,4 +88,12 @@ protected:
 
 	std::unique_ptr<lcView> mView;
 	std::unique_ptr<lcModel> mModel;
+
+/*** LPub3D Mod - thumbnail cache ***/
+	std::unordered_map<lcPartThumbnailKey, lcPartThumbnailId, lcPartThumbnailKeyHash> mThumbnailIds;
+	std::unordered_multimap<PieceInfo*, lcPartThumbnailId> mPendingThumbnails;
+	std::vector<lcPartThumbnailId> mDrawQueue;
+	QThreadPool mCacheThreadPool;
+	QString mCachePath;
+/*** LPub3D Mod end ***/
 };
@@ -106,6 +106,10 @@ void lcTimelineWidget::Update(bool Clear, bool UpdateItems)
 		mCurrentStepItem = nullptr;
 		mItems.clear();
 		clear();
+/*** LPub3D Mod - Timeline part icons ***/
+		mPieceIconInfo.clear();
+		mMissingPieceIcons.clear();
+/*** LPub3D Mod end ***/
 	}
 
 	lcStep LastStep = Model->GetLastStep();
@@ -153,6 +157,24 @@ void lcTimelineWidget::Update(bool Clear, bool UpdateItems)
 	QTreeWidgetItem* StepItem = nullptr;
 	int PieceItemIndex = 0;
 	lcStep Step = 0;
+/*** LPub3D Mod - Timeline large step updates ***/
+	// rows have uniform height, so the icon size is taken once per update
+	int IconSize = 0;
+	QModelIndex StepIndex;
+	QItemSelection ItemSelection;
+	QSet<lcPiece*> ModelPieces;
+
+	auto IsModelPiece = [&Pieces, &ModelPieces](lcPiece* CheckPiece)
+	{
+		if (ModelPieces.isEmpty())
+		{
+			ModelPieces.reserve(int(Pieces.size()));
+			for (const std::unique_ptr<lcPiece>& ModelPiece : Pieces)
+				ModelPieces.insert(ModelPiece.get());
+		}
+		return ModelPieces.contains(CheckPiece);
+	};
+/*** LPub3D Mod end ***/
 
 	for (const std::unique_ptr<lcPiece>& Piece : Pieces)
 	{
@@ -164,10 +186,10 @@ void lcTimelineWidget::Update(bool Clear, bool UpdateItems)
 				{
 					QTreeWidgetItem* PieceItem = StepItem->child(PieceItemIndex);
 					lcPiece* RemovePiece = (lcPiece*)PieceItem->data(0, Qt::UserRole).value<uintptr_t>();
-					auto RemoveIt = std::find_if(Pieces.begin(), Pieces.end(), [RemovePiece](const std::unique_ptr<lcPiece>& CheckPiece){ return CheckPiece.get() == RemovePiece; });
-
-					if (RemoveIt == Pieces.end())
+/*** LPub3D Mod - Timeline large step updates ***/
+					if (!IsModelPiece(RemovePiece))
 					{
+/*** LPub3D Mod end ***/
 						mItems.remove(RemovePiece);
 						delete PieceItem;
 					}
@@ -182,6 +204,9 @@ void lcTimelineWidget::Update(bool Clear, bool UpdateItems)
 			Step++;
 			StepItem = topLevelItem(Step - 1);
 			PieceItemIndex = 0;
+/*** LPub3D Mod - Timeline large step updates ***/
+			StepIndex = StepItem ? indexFromItem(StepItem) : QModelIndex();
+/*** LPub3D Mod end ***/
 		}
 
 		QTreeWidgetItem* PieceItem = mItems.value(Piece.get());
@@ -217,47 +242,20 @@ void lcTimelineWidget::Update(bool Clear, bool UpdateItems)
 		{
 			PieceItem->setText(0, Piece->mPieceInfo->m_strDescription);
 
-			int ColorIndex = Piece->GetColorIndex();
 /*** LPub3D Mod - Timeline part icons ***/
-			int Size = rowHeight(indexFromItem(PieceItem));
-
-			QFileInfo p = QFileInfo(Piece->GetID());
-			bool fPiece = (p.completeBaseName().right(4) == QString(LPUB3D_COLOUR_FADE_SUFFIX));
-			bool hPiece = (p.completeBaseName().right(9) == QString(LPUB3D_COLOUR_HIGHLIGHT_SUFFIX));
-			QString pieceName = p.completeBaseName().left(p.completeBaseName().size() - (fPiece ? 5 : hPiece ? 10 : 0)).append("." + p.suffix());
-
-			bool IsModel = gMainWindow->IsLPub3DSubModel(pieceName);
-			int IconIndex = IsModel ? SUBMODEL_ICON_INDEX_BASE + ColorIndex : ColorIndex;
-
-			if (lcGetPreferences().mViewPieceIcons && gMainWindow->mSubmodelIconsLoaded) {
+			if (IconSize <= 0)
+				IconSize = rowHeight(indexFromItem(PieceItem));
 
-				bool UseFColor = gApplication->UseLPubFadeColour();
-				bool Use0Code = IsModel && (hPiece || (fPiece && !gApplication->UseLPubFadeColour()) || (!hPiece && !fPiece));
-
-				QString colorCode = fPiece && UseFColor ? gApplication->LPubFadeColour() : QString("%1").arg(Piece->GetColorCode());
-				QString colorPrefix = IsModel ? fPiece ? LPUB3D_COLOUR_FADE_PREFIX : hPiece ? LPUB3D_COLOUR_HIGHLIGHT_PREFIX : QString() : fPiece && UseFColor ? LPUB3D_COLOUR_FADE_PREFIX : QString();
-				QString ImageKey = QString("%1_%2").arg(p.completeBaseName()).toLower().arg(QString("%1%2").arg(colorPrefix).arg(Use0Code ? QString("0") : colorCode));
-
-				if (GetPieceIcon(Size, ImageKey)) {
-
-					PieceItem->setIcon(0, mPieceIcons[ImageKey]);
-
-				} else {
-
-					GetIcon(Size,ColorIndex,IsModel);
-					PieceItem->setIcon(0, mIcons[IconIndex]);
-//#ifdef QT_DEBUG_MODE
-//					qDebug() << qPrintable(QString("ALERT - Could Not Insert %1 Icon - UID [%2]")
-//												   .arg(IsModel ? "Submodel" : "Piece")
-//												   .arg(ImageKey));
-//#endif
-				}
-
-			} else {
-
-				GetIcon(Size,ColorIndex,IsModel);
-				PieceItem->setIcon(0, mIcons[IconIndex]);
+			const lcTimelinePieceIcon& PieceIcon = GetPieceIconInfo(Piece.get());
 
+			if (lcGetPreferences().mViewPieceIcons && gMainWindow->mSubmodelIconsLoaded && GetPieceIcon(IconSize, PieceIcon.ImageKey))
+			{
+				PieceItem->setIcon(0, mPieceIcons[PieceIcon.ImageKey]);
+			}
+			else
+			{
+				GetIcon(IconSize, Piece->GetColorIndex(), PieceIcon.IsModel);
+				PieceItem->setIcon(0, mIcons[PieceIcon.IconIndex]);
 			}
 /*** LPub3D Mod end ***/
 
@@ -275,10 +273,25 @@ void lcTimelineWidget::Update(bool Clear, bool UpdateItems)
 /*** LPub3D Mod end ***/
 		}
 
-		PieceItem->setSelected(Piece->IsSelected());
+/*** LPub3D Mod - Timeline large step updates ***/
+		// select in one pass, merging adjacent rows
+		if (Piece->IsSelected() && StepItem)
+		{
+			const QModelIndex Index = model()->index(PieceItemIndex, 0, StepIndex);
+
+			if (!ItemSelection.isEmpty() && ItemSelection.last().parent() == StepIndex && ItemSelection.last().bottom() == PieceItemIndex - 1)
+				ItemSelection.last() = QItemSelectionRange(ItemSelection.last().topLeft(), Index);
+			else
+				ItemSelection.select(Index, Index);
+		}
+/*** LPub3D Mod end ***/
 		PieceItemIndex++;
 	}
 
+/*** LPub3D Mod - Timeline large step updates ***/
+	selectionModel()->select(ItemSelection, QItemSelectionModel::ClearAndSelect);
+/*** LPub3D Mod end ***/
+
 	if (Step == 0)
 	{
 		Step = 1;
@@ -360,10 +373,16 @@ bool lcTimelineWidget::GetPieceIcon(int Size, QString ImageKey) {
 
 	if (!mPieceIcons.contains(ImageKey))
 	{
+		if (mMissingPieceIcons.contains(ImageKey))
+			return false;
+
 		QFileInfo iconFile(gMainWindow->GetPliIconsPath(ImageKey));
 
 		if (!iconFile.exists())
+		{
+			mMissingPieceIcons.insert(ImageKey);
 			return false;
+		}
 
 		QImage RawImage(iconFile.absoluteFilePath());
 		RawImage = RawImage.convertToFormat(QImage::Format_ARGB32);
@@ -377,6 +396,39 @@ bool lcTimelineWidget::GetPieceIcon(int Size, QString ImageKey) {
 	}
 	return true;
 }
+
+// icon key and kind of a piece, cached by piece id and color
+const lcTimelineWidget::lcTimelinePieceIcon& lcTimelineWidget::GetPieceIconInfo(lcPiece* Piece)
+{
+	const QString PieceKey = QString("%1|%2").arg(Piece->GetID()).arg(Piece->GetColorCode());
+
+	QHash<QString, lcTimelinePieceIcon>::iterator it = mPieceIconInfo.find(PieceKey);
+
+	if (it != mPieceIconInfo.end())
+		return it.value();
+
+	int ColorIndex = Piece->GetColorIndex();
+
+	QFileInfo p = QFileInfo(Piece->GetID());
+	bool fPiece = (p.completeBaseName().right(4) == QString(LPUB3D_COLOUR_FADE_SUFFIX));
+	bool hPiece = (p.completeBaseName().right(9) == QString(LPUB3D_COLOUR_HIGHLIGHT_SUFFIX));
+	QString pieceName = p.completeBaseName().left(p.completeBaseName().size() - (fPiece ? 5 : hPiece ? 10 : 0)).append("." + p.suffix());
+
+	bool IsModel = gMainWindow->IsLPub3DSubModel(pieceName);
+
+	bool UseFColor = gApplication->UseLPubFadeColour();
+	bool Use0Code = IsModel && (hPiece || (fPiece && !gApplication->UseLPubFadeColour()) || (!hPiece && !fPiece));
+
+	QString colorCode = fPiece && UseFColor ? gApplication->LPubFadeColour() : QString("%1").arg(Piece->GetColorCode());
+	QString colorPrefix = IsModel ? fPiece ? LPUB3D_COLOUR_FADE_PREFIX : hPiece ? LPUB3D_COLOUR_HIGHLIGHT_PREFIX : QString() : fPiece && UseFColor ? LPUB3D_COLOUR_FADE_PREFIX : QString();
+
+	lcTimelinePieceIcon PieceIcon;
+	PieceIcon.ImageKey = QString("%1_%2").arg(p.completeBaseName()).toLower().arg(QString("%1%2").arg(colorPrefix).arg(Use0Code ? QString("0") : colorCode));
+	PieceIcon.IconIndex = IsModel ? SUBMODEL_ICON_INDEX_BASE + ColorIndex : ColorIndex;
+	PieceIcon.IsModel = IsModel;
+
+	return mPieceIconInfo.insert(PieceKey, PieceIcon).value();
+}
 /*** LPub3D Mod end ***/
 
 void lcTimelineWidget::UpdateSelection()
@@ -389,18 +441,31 @@ void lcTimelineWidget::UpdateSelection()
 	for (int TopLevelItemIdx = 0; TopLevelItemIdx < topLevelItemCount(); TopLevelItemIdx++)
 	{
 		QTreeWidgetItem* StepItem = topLevelItem(TopLevelItemIdx);
+/*** LPub3D Mod - Timeline large step updates ***/
+		const QModelIndex StepIndex = indexFromItem(StepItem);
+		int FirstSelected = -1;
 
-		for (int PieceItemIdx = 0; PieceItemIdx < StepItem->childCount(); PieceItemIdx++)
+		for (int PieceItemIdx = 0; PieceItemIdx <= StepItem->childCount(); PieceItemIdx++)
 		{
-			QTreeWidgetItem* PieceItem = StepItem->child(PieceItemIdx);
-			lcPiece* Piece = (lcPiece*)PieceItem->data(0, Qt::UserRole).value<uintptr_t>();
+			bool Selected = false;
 
-			if (Piece && Piece->IsSelected())
+			if (PieceItemIdx < StepItem->childCount())
 			{
-				QModelIndex Index = indexFromItem(PieceItem);
-				ItemSelection.select(Index, Index);
+				QTreeWidgetItem* PieceItem = StepItem->child(PieceItemIdx);
+				lcPiece* Piece = (lcPiece*)PieceItem->data(0, Qt::UserRole).value<uintptr_t>();
+				Selected = Piece && Piece->IsSelected();
+			}
+
+			// select runs of adjacent rows as one range
+			if (Selected && FirstSelected == -1)
+				FirstSelected = PieceItemIdx;
+			else if (!Selected && FirstSelected != -1)
+			{
+				ItemSelection.select(model()->index(FirstSelected, 0, StepIndex), model()->index(PieceItemIdx - 1, 0, StepIndex));
+				FirstSelected = -1;
 			}
 		}
+/*** LPub3D Mod end ***/
 	}
 
 	bool Blocked = blockSignals(true);
@@ -32,13 +32,25 @@ protected:
 	void UpdateModel();
 	void UpdateCurrentStepItem();
 /*** LPub3D Mod - Timeline part icons ***/
+	struct lcTimelinePieceIcon
+	{
+		QString ImageKey;
+		int IconIndex;
+		bool IsModel;
+	};
+
 	void GetIcon(int Size, int ColorIndex, bool IsModel);
 	bool GetPieceIcon(int Size, QString IconUID);
+	const lcTimelinePieceIcon& GetPieceIconInfo(lcPiece* Piece);
 
 	QMap<QString, QIcon> mPieceIcons;
+	QHash<QString, lcTimelinePieceIcon> mPieceIconInfo;
+	QSet<QString> mMissingPieceIcons;
 /*** LPub3D Mod end ***/
 	QMap<int, QIcon> mIcons;
-	QMap<lcPiece*, QTreeWidgetItem*> mItems;
+/*** LPub3D Mod - Timeline piece item lookup ***/
+	QHash<lcPiece*, QTreeWidgetItem*> mItems;
+/*** LPub3D Mod end ***/
 	QTreeWidgetItem* mCurrentStepItem;
 	bool mIgnoreUpdates;
 };
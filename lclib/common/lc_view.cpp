@@ -12,6 +12,9 @@
 #include "lc_synth.h"
 #include "lc_traintrack.h"
 #include "lc_scene.h"
+/*** LPub3D Mod - native software renderer ***/
+#include "lc_softwarerenderer.h"
+/*** LPub3D Mod end ***/
 #include "lc_context.h"
 #include "lc_viewmanipulator.h"
 #include "lc_viewsphere.h"
@@ -27,6 +30,10 @@ QPointer<lcFindReplaceWidget> lcView::mFindWidget;
 
 lcView* lcView::mLastFocusedView;
 std::vector<lcView*> lcView::mViews;
+/*** LPub3D Mod - native render session ***/
+std::unique_ptr<QOpenGLFramebufferObject> lcView::mSharedRenderFramebuffer;
+QOpenGLFramebufferObjectFormat lcView::mSharedRenderFramebufferFormat;
+/*** LPub3D Mod end ***/
 
 /*** LPub3D Mod - preview widget for LPub3D ***/
 lcView::lcView(lcViewType ViewType, lcModel* Model, bool SubstituteView)
@@ -214,7 +221,57 @@ void lcView::DestroyResources(lcContext* Context)
 
 	delete gGridTexture;
 	gGridTexture = nullptr;
+/*** LPub3D Mod - native render session ***/
+	ReleaseSharedRenderFramebuffer();
+/*** LPub3D Mod end ***/
+}
+
+/*** LPub3D Mod - native render session ***/
+void lcView::ReleaseSharedRenderFramebuffer()
+{
+	mSharedRenderFramebuffer.reset();
+}
+/*** LPub3D Mod end ***/
+
+/*** LPub3D Mod - native software renderer ***/
+bool lcView::RenderToImageSoftware(int Width, int Height)
+{
+	if (!mModel || Width <= 0 || Height <= 0)
+		return false;
+
+	mWidth = Width;
+	mHeight = Height;
+
+	const lcPreferences& Preferences = lcGetPreferences();
+
+	lcShadingMode ShadingMode = Preferences.mShadingMode;
+	if (ShadingMode == lcShadingMode::Wireframe)
+		ShadingMode = lcShadingMode::Flat;
+
+	mScene->SetShadingMode(ShadingMode);
+	mScene->SetAllowLOD(false);
+	mScene->SetLODDistance(Preferences.mMeshLODDistance);
+
+	mScene->Begin(mCamera->mWorldView);
+	mScene->SetActiveSubmodelInstance(mActiveSubmodelInstance, mActiveSubmodelTransform);
+	mScene->SetDrawInterface(false);
+
+	mModel->GetScene(mScene.get(), mCamera, Preferences.mHighlightNewParts, Preferences.mFadeSteps);
+
+	mScene->End();
+
+	lcSoftwareRenderer Renderer(Width, Height);
+
+	Renderer.SetLineWidth(Preferences.mLineWidth);
+
+	if (mOverrideBackgroundColor)
+		Renderer.SetBackgroundColor(lcVector4FromColor(mBackgroundColor));
+	else
+		Renderer.SetBackgroundColor(lcVector4(lcVector3FromColor(Preferences.mBackgroundSolidColor), 0.0f));
+
+	return Renderer.Render(mScene.get(), GetProjectionMatrix(), mRenderImage);
 }
+/*** LPub3D Mod end ***/
 
 void lcView::RemoveCamera()
 {
@@ -850,13 +907,32 @@ bool lcView::BeginRenderToImage(int Width, int Height)
 	if (QSurfaceFormat::defaultFormat().samples() > 1)
 		Format.setSamples(QSurfaceFormat::defaultFormat().samples());
 
-	mRenderFramebuffer = std::unique_ptr<QOpenGLFramebufferObject>(new QOpenGLFramebufferObject(QSize(TileWidth, TileHeight), Format));
+/*** LPub3D Mod - native render session ***/
+	// Offscreen renders that are issued back to back on the global offscreen context
+	// share one framebuffer as long as the tile size and format do not change.
+	const QSize TileSize(TileWidth, TileHeight);
+	if (mReuseRenderFramebuffer && mSharedRenderFramebuffer && mSharedRenderFramebuffer->size() == TileSize && mSharedRenderFramebufferFormat == Format)
+		mRenderFramebuffer = std::move(mSharedRenderFramebuffer);
+	else
+		mRenderFramebuffer = std::unique_ptr<QOpenGLFramebufferObject>(new QOpenGLFramebufferObject(TileSize, Format));
+
+	if (mReuseRenderFramebuffer)
+		mSharedRenderFramebufferFormat = Format;
+/*** LPub3D Mod end ***/
 
 	return mRenderFramebuffer->bind();
 }
 
 void lcView::EndRenderToImage()
 {
+/*** LPub3D Mod - native render session ***/
+	if (mReuseRenderFramebuffer && mRenderFramebuffer)
+	{
+		mRenderFramebuffer->release();
+		mSharedRenderFramebuffer = std::move(mRenderFramebuffer);
+		return;
+	}
+/*** LPub3D Mod end ***/
 	mRenderFramebuffer.reset();
 }
 
@@ -300,6 +300,16 @@ public:
 	QImage GetRenderFramebufferImage() const;
 	std::vector<QImage> GetStepImages(lcStep Start, lcStep End);
 	void SaveStepImages(const QString& BaseName, bool AddStepSuffix, lcStep Start, lcStep End, std::function<void(const QString&)> ProgressCallback);
+/*** LPub3D Mod - native render session ***/
+	void SetReuseRenderFramebuffer(bool Reuse)
+	{
+		mReuseRenderFramebuffer = Reuse;
+	}
+	static void ReleaseSharedRenderFramebuffer();
+/*** LPub3D Mod end ***/
+/*** LPub3D Mod - native software renderer ***/
+	bool RenderToImageSoftware(int Width, int Height);
+/*** LPub3D Mod end ***/
 
 	lcContext* mContext = nullptr;
 
@@ -386,4 +396,9 @@ protected:
 /*** LPub3D Mod - preview widget for LPub3D ***/
 	bool mIsSubstituteView = false;
 /*** LPub3D Mod end ***/
+/*** LPub3D Mod - native render session ***/
+	bool mReuseRenderFramebuffer = false;
+	static std::unique_ptr<QOpenGLFramebufferObject> mSharedRenderFramebuffer;
+	static QOpenGLFramebufferObjectFormat mSharedRenderFramebufferFormat;
+/*** LPub3D Mod end ***/
 };
@@ -79,12 +79,19 @@ void lcHTMLExportOptions::SaveDefaults()
 /*** LPub3D Mod end ***/
 }
 
+/*** LPub3D Mod - native render session ***/
+quint64 Project::mNextSerial = 0;
+/*** LPub3D Mod end ***/
+
 /*** LPub3D Mod - Render Image ***/
 Project::Project(bool IsPreview, bool IsRenderImage)
 	: mIsPreview(IsPreview), mRenderImage(IsRenderImage)
 /*** LPub3D Mod end ***/
 {
 	mModified = false;
+/*** LPub3D Mod - native render session ***/
+	mSerial = ++mNextSerial;
+/*** LPub3D Mod end ***/
 /*** LPub3D Mod - viewer step key ***/
 	mImageType = Options::PLI;
 /*** LPub3D Mod end ***/
@@ -72,6 +72,12 @@ public:
 		return mRenderImage;
 	}
 /*** LPub3D Mod end ***/
+/*** LPub3D Mod - native render session ***/
+	quint64 GetSerial() const
+	{
+		return mSerial;
+	}
+/*** LPub3D Mod end ***/
 /*** LPub3D Mod - project piece ***/
 	bool IsModified(const QString &FileName, bool reset) const;
 /*** LPub3D Mod end ***/
@@ -259,6 +265,10 @@ protected:
 /*** LPub3D Mod - set Timeline top item ***/
 	QString mTimelineTopItem;
 /*** LPub3D Mod end ***/
+/*** LPub3D Mod - native render session ***/
+	quint64 mSerial;
+	static quint64 mNextSerial;
+/*** LPub3D Mod end ***/
 };
 
 inline lcModel* lcGetActiveModel()
@@ -52,6 +52,7 @@ HEADERS += \
 	$$PWD/common/lc_propertieswidget.h \
     $$PWD/common/lc_scene.h \
     $$PWD/common/lc_shortcuts.h \
+    $$PWD/common/lc_softwarerenderer.h \
     $$PWD/common/lc_stringcache.h \
     $$PWD/common/lc_synth.h \
     $$PWD/common/lc_texture.h \
@@ -124,6 +125,7 @@ SOURCES += \
 	$$PWD/common/lc_propertieswidget.cpp \
     $$PWD/common/lc_scene.cpp \
     $$PWD/common/lc_shortcuts.cpp \
+    $$PWD/common/lc_softwarerenderer.cpp \
     $$PWD/common/lc_stringcache.cpp \
     $$PWD/common/lc_synth.cpp \
     $$PWD/common/lc_texture.cpp \
@@ -101,6 +101,9 @@
 
 LDVWidget* ldvWidget;
 
+LDVWidget *LDVWidget::exportSession = nullptr;
+int LDVWidget::iniFileGeneration = 0;
+
 const QString iniFlagNames [] =
 {
 	"Native POV",
@@ -114,6 +117,7 @@ const QString iniFlagNames [] =
 
 LDVWidget::LDVWidget(QWidget *parent, IniFlag iniflag, bool forceIni)
 		: QGLWidget(parent),
+		sessionIniGeneration(-1),
 		iniFlag(iniflag),
 		forceIni(forceIni),
 		darkTheme(Preferences::darkTheme),
@@ -154,12 +158,18 @@ LDVWidget::LDVWidget(QWidget *parent, IniFlag iniflag, bool forceIni)
 	if (!setIniFile())
 		return;
 
-	const QString ldvMessages = QDir::toNativeSeparators(QString("%1%2")
-												  .arg(Preferences::dataLocation)
-												  .arg(VER_LDVMESSAGESINI_FILE));
-	if (!TCLocalStrings::loadStringTable(copyString(ldvMessages.toUtf8().constData())))
-		emit lpub->messageSig(LOG_ERROR,
-							  QString::fromWCharArray(TCLocalStrings::get(L"LoadLDVMessagesError")).arg(ldvMessages));
+	// the message table is process wide, so it is loaded by the first widget only
+	static bool ldvMessagesLoaded = false;
+	if (!ldvMessagesLoaded)
+	{
+		const QString ldvMessages = QDir::toNativeSeparators(QString("%1%2")
+													  .arg(Preferences::dataLocation)
+													  .arg(VER_LDVMESSAGESINI_FILE));
+		ldvMessagesLoaded = TCLocalStrings::loadStringTable(copyString(ldvMessages.toUtf8().constData()));
+		if (!ldvMessagesLoaded)
+			emit lpub->messageSig(LOG_ERROR,
+								  QString::fromWCharArray(TCLocalStrings::get(L"LoadLDVMessagesError")).arg(ldvMessages));
+	}
 
 	LDLModel::setFileCaseCallback(staticFileCaseCallback);
 
@@ -195,9 +205,36 @@ LDVWidget::~LDVWidget(void)
 	TCObject::release(ldvAlertHandler);
 	ldvAlertHandler = NULL;
 
+	if (exportSession == this)
+		exportSession = nullptr;
+
 	ldvWidget = nullptr;
 }
 
+/*
+ * Return the native export widget kept for the run. The GL context,
+ * message table and preference session are set up by the first call.
+ * The ini is set again only when the ini flag changes or another
+ * widget has set an ini file since the last export.
+ */
+LDVWidget *LDVWidget::nativeExportSession(IniFlag iniflag)
+{
+	if (!exportSession)
+	{
+		exportSession = new LDVWidget(nullptr, iniflag, true);
+		exportSession->sessionIniGeneration = iniFileGeneration;
+	}
+	else if (exportSession->iniFlag != iniflag || exportSession->sessionIniGeneration != iniFileGeneration)
+	{
+		exportSession->setIni(iniflag);
+		exportSession->sessionIniGeneration = iniFileGeneration;
+	}
+
+	ldvWidget = exportSession;
+
+	return exportSession;
+}
+
 void LDVWidget::showLDVPreferences()
 {
 	setupLDVApplication();
@@ -333,7 +370,8 @@ bool LDVWidget::setFontSettings(void)
 
 bool LDVWidget::setStudLogo(void)
 {
-	QImage studImage(":/resources/StudLogo.png");
+	// kept for the run, the stud texture is set for every command
+	static QImage studImage(":/resources/StudLogo.png");
 	if (studImage.isNull())
 	{
 		emit lpub->messageSig(LOG_ERROR,
@@ -365,6 +403,7 @@ bool LDVWidget::setIni(IniFlag iniflag)
 
 bool LDVWidget::setIniFile(const char* value)
 {
+	iniFileGeneration++;
 	return TCUserDefaults::setIniFile(value);
 }
 
@@ -63,6 +63,7 @@ public:
 	static bool staticFileCaseLevel(QDir &dir, char *filename);
 	static bool setIniFile(const char* value);
 	static char *getExportsDir(void);
+	static LDVWidget *nativeExportSession(IniFlag iniflag);
 
 	static void messageSig(LogType type, const QString &message, int = 0);
 
@@ -136,6 +137,10 @@ protected:
 	void setLibraryUpdateProgress(float progress);
 	LDSnapshotTaker::ImageType getSaveImageType(void);
 
+	static LDVWidget      *exportSession;
+	static int             iniFileGeneration;
+	int                    sessionIniGeneration;
+
 	IniFlag                iniFlag;
 	bool                   forceIni;
 	int                    darkTheme;
@@ -20,6 +20,7 @@
 #include <QFileInfo>
 #include <QTextStream>
 #include <QCheckBox>
+#include <QCryptographicHash>
 #include "lpub_preferences.h"
 #include "declarations.h"
 #include "version.h"
@@ -32,6 +33,11 @@ QList<QString>              Annotations::titleAnnotations;
 QHash<QString, QString>     Annotations::freeformAnnotations;
 QHash<QString, QStringList> Annotations::annotationStyles;
 
+QList<QRegExp>              Annotations::titleAnnotationRx;
+QStringList                 Annotations::titleAnnotationPrefix;
+QHash<QString, QString>     Annotations::titleAnnotationMatches;
+QSet<QString>               Annotations::titleAnnotationMisses;
+
 QHash<QString, QStringList> Annotations::blCodes;
 QHash<QString, QString>     Annotations::userElements;
 QHash<QString, QString>     Annotations::blColors;
@@ -43,6 +49,8 @@ QHash<QString, QString>     Annotations::ld2rbCodesXRef;
 
 QList<Where>                Annotations::AnnotationErrors;
 
+ReferenceTable              Annotations::referenceTables[NumReferenceTables];
+
 void Annotations::loadLD2BLColorsXRef(QByteArray& Buffer) {
 /*
 # File: ld2blcolorsxref.lst
@@ -1337,6 +1345,7 @@ Annotations::Annotations()
                 }
             }
         }
+        compileTitleAnnotations();
     }
 
     if (freeformAnnotations.size() == 0) {
@@ -1493,234 +1502,188 @@ Annotations::Annotations()
         }
     }
 
-    if (ld2blColorsXRef.size() == 0) {
-        QString ld2blColorsXRefFile = Preferences::ld2blColorsXRefFile;
-        QRegExp rx("^([^\\t]+)\\t+\\s*([^\\t]+).*$");
-        if (QFileInfo::exists(ld2blColorsXRefFile)) {
-            QFile file(ld2blColorsXRefFile);
-            if ( ! file.open(QFile::ReadOnly | QFile::Text)) {
-                title = QObject::tr("LDraw to BrickLink Color Reference");
-                message = messageInsert.arg(ld2blColorsXRefFile, title, file.errorString());
-                Where where(file.fileName());
-                annotationMessage(message, where);
-                return;
-            }
-            QTextStream in(&file);
+    // LDraw to BrickLink and Rebrickable cross references are loaded on first lookup
+}
 
-            // Load RegExp from file;
-            QRegExp rxin("^#[\\w\\s]+\\:[\\s](\\^.*)$");
-            while ( ! in.atEnd()) {
-                QString sLine = in.readLine(0);
-                if (sLine.contains(rxin)) {
-                    rx.setPattern(rxin.cap(1));
-                    //logDebug() << "LD2BL ColorsXRef RegExp Pattern: " << rxin.cap(1);
-                    break;
-                }
-            }
+/*
+ * Reference tables are compiled into the user cache folder on first load.
+ */
+QString Annotations::referenceTablePath(ReferenceTableType type)
+{
+    static const char *tableNames[NumReferenceTables] = {
+        "ld2blcolorsxref",
+        "ld2blcodesxref",
+        "ld2rbcolorsxref",
+        "ld2rbcodesxref",
+        "blcodes",
+        "userelements"
+    };
+    return QDir::toNativeSeparators(QString("%1/reference/%2.bin")
+                                            .arg(Preferences::lpub3dCachePath)
+                                            .arg(tableNames[type]));
+}
 
-            // Load input values
-            in.seek(0);
-            while ( ! in.atEnd()) {
-                QString sLine = in.readLine(0);
-                if (sLine.contains(rx)) {
-                    QString ldcolorid = rx.cap(1);
-                    QString blcolorid = rx.cap(2).trimmed();
-                    ld2blColorsXRef[ldcolorid.toLower()] = blcolorid;
-                }
-            }
-        } else {
-            ld2blColorsXRef.clear();
-            QByteArray Buffer;
-            loadLD2BLColorsXRef(Buffer);
-            QTextStream instream(Buffer);
-            for (QString sLine = instream.readLine(); !sLine.isNull(); sLine = instream.readLine())
-            {
-                QChar comment = sLine.at(0);
-                if (comment == '#' || comment == ' ')
-                    continue;
-                if (sLine.contains(rx)) {
-                    QString ldcolorid = rx.cap(1);
-                    QString blcolorid = rx.cap(2).trimmed();
-                    ld2blColorsXRef[ldcolorid.toLower()] = blcolorid;
-                }
-            }
-        }
+QHash<QString, QString> &Annotations::xrefHash(ReferenceTableType type)
+{
+    switch (type) {
+    case LD2BLCodesXRefTable:
+        return ld2blCodesXRef;
+    case LD2RBColorsXRefTable:
+        return ld2rbColorsXRef;
+    case LD2RBCodesXRefTable:
+        return ld2rbCodesXRef;
+    default:
+        return ld2blColorsXRef;
     }
+}
 
-    if (ld2blCodesXRef.size() == 0) {
-        QString ld2blCodesXRefFile = Preferences::ld2blCodesXRefFile;
-        QRegExp rx("^([^\\t]+)\\t+\\s*([^\\t]+).*$");
-        if (QFileInfo::exists(ld2blCodesXRefFile)) {
-            QFile file(ld2blCodesXRefFile);
-            if ( ! file.open(QFile::ReadOnly | QFile::Text)) {
-                title = QObject::tr("LDraw to BrickLink Design ID Reference");
-                message = messageInsert.arg(ld2blCodesXRefFile, title, file.errorString());
-                Where where(file.fileName());
-                annotationMessage(message, where);
-                return;
-            }
-            QTextStream in(&file);
+// replace the parsed rows with the compiled table
+void Annotations::compileReferenceTable(ReferenceTableType type, const QByteArray &stamp, const QHash<QString, QStringList> &rows, int columns)
+{
+    if (!referenceTables[type].create(referenceTablePath(type), stamp, rows, columns))
+        logNotice() << QString("Could not write reference table %1.").arg(referenceTablePath(type));
+}
 
-            // Load RegExp from file;
-            QRegExp rxin("^#[\\w\\s]+\\:[\\s](\\^.*)$");
-            while ( ! in.atEnd()) {
-                QString sLine = in.readLine(0);
-                if (sLine.contains(rxin)) {
-                    rx.setPattern(rxin.cap(1));
-                    //logDebug() << "LD2BL CodesXRef RegExp Pattern: " << rxin.cap(1);
-                    break;
-                }
-            }
+// key: ldcolorid or ldpartid
+// val: blcolorid, blitemid, rbcolorid or rbitemid
+bool Annotations::loadXRef(ReferenceTableType type)
+{
+    QHash<QString, QString> &xref = xrefHash(type);
 
-            // Load input values
-            in.seek(0);
-            while ( ! in.atEnd()) {
-                QString sLine = in.readLine(0);
-                if (sLine.contains(rx)) {
-                    QString ldpartid = rx.cap(1);
-                    QString blitemid = rx.cap(2).trimmed();
-                    ld2blCodesXRef[ldpartid.toLower()] = blitemid;
-                }
-            }
-        } else {
-            ld2blCodesXRef.clear();
-            QByteArray Buffer;
+    if (referenceTables[type].isOpen() || xref.size())
+        return true;
+
+    QString xrefFile, title;
+    QByteArray Buffer;
+    switch (type) {
+    case LD2BLColorsXRefTable:
+        xrefFile = Preferences::ld2blColorsXRefFile;
+        title = QObject::tr("LDraw to BrickLink Color Reference");
+        if (!QFileInfo::exists(xrefFile))
+            loadLD2BLColorsXRef(Buffer);
+        break;
+    case LD2BLCodesXRefTable:
+        xrefFile = Preferences::ld2blCodesXRefFile;
+        title = QObject::tr("LDraw to BrickLink Design ID Reference");
+        if (!QFileInfo::exists(xrefFile))
             loadLD2BLCodesXRef(Buffer);
-            QTextStream instream(Buffer);
-            for (QString sLine = instream.readLine(); !sLine.isNull(); sLine = instream.readLine())
-            {
-                QChar comment = sLine.at(0);
-                if (comment == '#' || comment == ' ')
-                    continue;
-                if (sLine.contains(rx)) {
-                    QString ldpartid = rx.cap(1);
-                    QString blitemid = rx.cap(2).trimmed();
-                    ld2blCodesXRef[ldpartid.toLower()] = blitemid;
-                }
-            }
-        }
+        break;
+    case LD2RBColorsXRefTable:
+        xrefFile = Preferences::ld2rbColorsXRefFile;
+        title = QObject::tr("LDraw to Rebrickable Color Reference");
+        if (!QFileInfo::exists(xrefFile))
+            loadLD2RBColorsXRef(Buffer);
+        break;
+    case LD2RBCodesXRefTable:
+        xrefFile = Preferences::ld2rbCodesXRefFile;
+        title = QObject::tr("LDraw to Rebrickable Design ID Reference");
+        if (!QFileInfo::exists(xrefFile))
+            loadLD2RBCodesXRef(Buffer);
+        break;
+    default:
+        return false;
     }
 
-    // Rebrickable Codes
+    const bool fileFound = Buffer.isEmpty();
+    const QByteArray stamp = fileFound ? ReferenceTable::fileStamp(xrefFile)
+                                       : "builtin|" + QCryptographicHash::hash(Buffer, QCryptographicHash::Md5).toHex();
 
-    if (ld2rbColorsXRef.size() == 0) {
-        QString ld2rbColorsXRefFile = Preferences::ld2rbColorsXRefFile;
-        QRegExp rx("^([^\\t]+)\\t+\\s*([^\\t]+).*$");
-        if (QFileInfo::exists(ld2rbColorsXRefFile)) {
-            QFile file(ld2rbColorsXRefFile);
-            if ( ! file.open(QFile::ReadOnly | QFile::Text)) {
-                title = QObject::tr("LDraw to Rebrickable Color Reference");
-                message = messageInsert.arg(ld2rbColorsXRefFile, title, file.errorString());
-                Where where(file.fileName());
-                annotationMessage(message, where);
-                return;
-            }
-            QTextStream in(&file);
+    if (referenceTables[type].open(referenceTablePath(type), stamp))
+        return true;
 
-            // Load RegExp from file;
-            QRegExp rxin("^#[\\w\\s]+\\:[\\s](\\^.*)$");
-            while ( ! in.atEnd()) {
-                QString sLine = in.readLine(0);
-                if (sLine.contains(rxin)) {
-                    rx.setPattern(rxin.cap(1));
-                    //logDebug() << "LD2RB ColorsXRef RegExp Pattern: " << rxin.cap(1);
-                    break;
-                }
+    QRegExp rx("^([^\\t]+)\\t+\\s*([^\\t]+).*$");
+    if (fileFound) {
+        QFile file(xrefFile);
+        if ( ! file.open(QFile::ReadOnly | QFile::Text)) {
+            QString message = messageInsert.arg(xrefFile, title, file.errorString());
+            Where where(file.fileName());
+            annotationMessage(message, where);
+            return false;
+        }
+        QTextStream in(&file);
+
+        // Load RegExp from file;
+        QRegExp rxin("^#[\\w\\s]+\\:[\\s](\\^.*)$");
+        while ( ! in.atEnd()) {
+            QString sLine = in.readLine(0);
+            if (sLine.contains(rxin)) {
+                rx.setPattern(rxin.cap(1));
+                break;
             }
+        }
 
-            // Load input values
-            in.seek(0);
-            while ( ! in.atEnd()) {
-                QString sLine = in.readLine(0);
-                if (sLine.contains(rx)) {
-                    QString ldcolorid = rx.cap(1);
-                    QString rbcolorid = rx.cap(2).trimmed();
-                    ld2rbColorsXRef[ldcolorid.toLower()] = rbcolorid;
-                }
+        // Load input values
+        in.seek(0);
+        while ( ! in.atEnd()) {
+            QString sLine = in.readLine(0);
+            if (sLine.contains(rx)) {
+                QString key = rx.cap(1);
+                QString value = rx.cap(2).trimmed();
+                xref[key.toLower()] = value;
             }
-        } else {
-            ld2rbColorsXRef.clear();
-            QByteArray Buffer;
-            loadLD2RBColorsXRef(Buffer);
-            QTextStream instream(Buffer);
-            for (QString sLine = instream.readLine(); !sLine.isNull(); sLine = instream.readLine())
-            {
-                QChar comment = sLine.at(0);
-                if (comment == '#' || comment == ' ')
-                    continue;
-                if (sLine.contains(rx)) {
-                    QString ldcolorid = rx.cap(1);
-                    QString rbcolorid = rx.cap(2).trimmed();
-                    ld2rbColorsXRef[ldcolorid.toLower()] = rbcolorid;
-                }
+        }
+    } else {
+        QTextStream instream(Buffer);
+        for (QString sLine = instream.readLine(); !sLine.isNull(); sLine = instream.readLine())
+        {
+            if (sLine.isEmpty())
+                continue;
+            QChar comment = sLine.at(0);
+            if (comment == '#' || comment == ' ')
+                continue;
+            if (sLine.contains(rx)) {
+                QString key = rx.cap(1);
+                QString value = rx.cap(2).trimmed();
+                xref[key.toLower()] = value;
             }
         }
     }
 
-    if (ld2rbCodesXRef.size() == 0) {
-        QString ld2rbCodesXRefFile = Preferences::ld2rbCodesXRefFile;
-        QRegExp rx("^([^\\t]+)\\t+\\s*([^\\t]+).*$");
-        if (QFileInfo::exists(ld2rbCodesXRefFile)) {
-            QFile file(ld2rbCodesXRefFile);
-            if ( ! file.open(QFile::ReadOnly | QFile::Text)) {
-                title = QObject::tr("LDraw to Rebrickable Design ID Reference");
-                message = messageInsert.arg(ld2rbCodesXRefFile, title, file.errorString());
-                Where where(file.fileName());
-                annotationMessage(message, where);
-                return;
-            }
-            QTextStream in(&file);
+    QHash<QString, QStringList> rows;
+    for (QHash<QString, QString>::const_iterator it = xref.constBegin(); it != xref.constEnd(); ++it)
+        rows.insert(it.key(), QStringList() << it.value());
 
-            // Load RegExp from file;
-            QRegExp rxin("^#[\\w\\s]+\\:[\\s](\\^.*)$");
-            while ( ! in.atEnd()) {
-                QString sLine = in.readLine(0);
-                if (sLine.contains(rxin)) {
-                    rx.setPattern(rxin.cap(1));
-                    //logDebug() << "LD2RB CodesXRef RegExp Pattern: " << rxin.cap(1);
-                    break;
-                }
-            }
+    compileReferenceTable(type, stamp, rows, 1);
+    if (referenceTables[type].isOpen())
+        xref.clear();
 
-            // Load input values
-            in.seek(0);
-            while ( ! in.atEnd()) {
-                QString sLine = in.readLine(0);
-                if (sLine.contains(rx)) {
-                    QString ldpartid = rx.cap(1);
-                    QString rbitemid = rx.cap(2).trimmed();
-                    ld2rbCodesXRef[ldpartid.toLower()] = rbitemid;
-                }
-            }
-        } else {
-            ld2rbCodesXRef.clear();
-            QByteArray Buffer;
-            loadLD2RBCodesXRef(Buffer);
-            QTextStream instream(Buffer);
-            for (QString sLine = instream.readLine(); !sLine.isNull(); sLine = instream.readLine())
-            {
-                QChar comment = sLine.at(0);
-                if (comment == '#' || comment == ' ')
-                    continue;
-                if (sLine.contains(rx)) {
-                    QString ldpartid = rx.cap(1);
-                    QString rbitemid = rx.cap(2).trimmed();
-                    ld2rbCodesXRef[ldpartid.toLower()] = rbitemid;
-                }
-            }
-        }
+    return true;
+}
+
+bool Annotations::xrefValue(ReferenceTableType type, const QString &key, QString &value)
+{
+    loadXRef(type);
+
+    const ReferenceTable &table = referenceTables[type];
+    if (table.isOpen()) {
+        const int row = table.find(key);
+        if (row < 0)
+            return false;
+        value = table.value(row);
+        return true;
     }
+
+    const QHash<QString, QString> &xref = xrefHash(type);
+    QHash<QString, QString>::const_iterator it = xref.constFind(key.toLower());
+    if (it == xref.constEnd())
+        return false;
+    value = it.value();
+    return true;
 }
 
 // key : blitemid+blcolorid
 // val1: blitemid+"-"+blcolorid
 // val2: elementid
 bool Annotations::loadBLCodes() {
-    if (blCodes.size() == 0) {
+    if (blCodes.size() == 0 && !referenceTables[BLCodesTable].isOpen()) {
         QString message;
         QString blCodesFile = Preferences::blCodesFile;
         QRegExp rx("^([^\\t]+)\\t+\\s*([^\\t]+)\\t+\\s*([^\\t]+).*$");
         if (QFileInfo::exists(blCodesFile)) {
+            // BrickLink colour names are resolved to colour ids while loading
+            const QByteArray stamp = ReferenceTable::fileStamp(blCodesFile) + ReferenceTable::fileStamp(Preferences::blColorsFile);
+            if (referenceTables[BLCodesTable].open(referenceTablePath(BLCodesTable), stamp))
+                return true;
             QFile file(blCodesFile);
             if ( ! file.open(QFile::ReadOnly | QFile::Text)) {
                 message = QObject::tr("Failed to open BrickLink Codes Reference<br>%1.<br>%2")
@@ -1756,6 +1719,9 @@ bool Annotations::loadBLCodes() {
 // DEBUG -->>>
 //            Stream.flush();
 // DEBUG <<<---
+            compileReferenceTable(BLCodesTable, stamp, blCodes, 2);
+            if (referenceTables[BLCodesTable].isOpen())
+                blCodes.clear();
         } else {
             // return false to trigger codes.txt download
             return  false;
@@ -1765,7 +1731,7 @@ bool Annotations::loadBLCodes() {
 }
 
 bool Annotations::loadBLCodes(QByteArray &Buffer) {
-    if (blCodes.size() == 0) {
+    if (blCodes.size() == 0 && !referenceTables[BLCodesTable].isOpen()) {
         QString message;
         QRegExp rx("^([^\\t]+)\\t+\\s*([^\\t]+)\\t+\\s*([^\\t]+).*$");
         QTextStream instream(Buffer);
@@ -1804,6 +1770,11 @@ bool Annotations::loadBLCodes(QByteArray &Buffer) {
             outstream.flush();
             file.close();
 
+            const QByteArray stamp = ReferenceTable::fileStamp(blCodesFile) + ReferenceTable::fileStamp(Preferences::blColorsFile);
+            compileReferenceTable(BLCodesTable, stamp, blCodes, 2);
+            if (referenceTables[BLCodesTable].isOpen())
+                blCodes.clear();
+
             message = QObject::tr("Finished Writing, Proceed %1 lines for file [%2]")
                               .arg(counter).arg(blCodesFile);
             if (Preferences::modeGUI)
@@ -1826,7 +1797,7 @@ bool Annotations::loadBLCodes(QByteArray &Buffer) {
 // key: ldpartid+ldcolorid
 // val: elementid
 bool Annotations::loadUserElements(bool useLDrawKey) {
-    if (userElements.size() == 0) {
+    if (userElements.size() == 0 && !referenceTables[UserElementsTable].isOpen()) {
         QString message;
         QString userElementsFile =  Preferences::userElementsFile.isEmpty()
                                   ? QDir::toNativeSeparators(QString("%1/extras/%2").arg(Preferences::lpubDataPath,VER_LPUB3D_USERELEMENTS_FILE))
@@ -1837,6 +1808,10 @@ bool Annotations::loadUserElements(bool useLDrawKey) {
             userElementsFile = QString("%1/extras/%2").arg(Preferences::lpubDataPath,VER_LPUB3D_LEGOELEMENTS_FILE);
         QRegExp rx("^([^\\t]+)\\t+\\s*([^\\t]+)\\t+\\s*([^\\t]+).*$");
         if (fileFound || QFileInfo::exists(userElementsFile)) {
+            const QByteArray stamp = ReferenceTable::fileStamp(userElementsFile) +
+                                     (useLDrawKey ? QByteArray("ldrawkey;") : ReferenceTable::fileStamp(Preferences::blColorsFile));
+            if (referenceTables[UserElementsTable].open(referenceTablePath(UserElementsTable), stamp))
+                return true;
             QFile file(userElementsFile);
             if ( ! file.open(QFile::ReadOnly | QFile::Text)) {
                 QString title = QObject::tr("User Part Elements Reference");
@@ -1870,6 +1845,13 @@ bool Annotations::loadUserElements(bool useLDrawKey) {
                     //qDebug() << qPrintable(QString("LOAD: %1=%2").arg(QString(ldpartid+ldcolorid).toLower(), elementid));
                 }
             }
+
+            QHash<QString, QStringList> rows;
+            for (QHash<QString, QString>::const_iterator it = userElements.constBegin(); it != userElements.constEnd(); ++it)
+                rows.insert(it.key(), QStringList() << it.value());
+            compileReferenceTable(UserElementsTable, stamp, rows, 1);
+            if (referenceTables[UserElementsTable].isOpen())
+                userElements.clear();
         } else {
             message = QObject::tr("Failed to open User-defined Part Elements file.<br>%1").arg(userElementsFile);
             Where where(userElementsFile);
@@ -1887,6 +1869,98 @@ const QString &Annotations::freeformAnnotation(QString part)
     return returnString;
 }
 
+/*
+ * Compile the title annotation patterns and reset the part memo.
+ * Patterns anchored on a literal title prefix, e.g. ^Technic Axle\s+...,
+ * keep that prefix so titles that cannot match skip the regular expression.
+ */
+void Annotations::compileTitleAnnotations()
+{
+    titleAnnotationRx.clear();
+    titleAnnotationPrefix.clear();
+    titleAnnotationMatches.clear();
+    titleAnnotationMisses.clear();
+
+    static const QString metaCharacters("\\.^$|?*+()[]{}");
+    static const QString quantifiers("?*+{");
+
+    // an alternation outside groups and classes can match without the prefix
+    auto topLevelAlternation = [] (const QString &pattern)
+    {
+        int depth = 0;
+        bool charClass = false;
+        for (int i = 0; i < pattern.size(); i++) {
+            const QChar c = pattern.at(i);
+            if (c == QLatin1Char('\\'))
+                i++;
+            else if (charClass)
+                charClass = c != QLatin1Char(']');
+            else if (c == QLatin1Char('['))
+                charClass = true;
+            else if (c == QLatin1Char('('))
+                depth++;
+            else if (c == QLatin1Char(')'))
+                depth--;
+            else if (c == QLatin1Char('|') && depth == 0)
+                return true;
+        }
+        return false;
+    };
+
+    for (const QString &pattern : titleAnnotations) {
+        QString prefix;
+        if (pattern.startsWith(QLatin1Char('^')) && !topLevelAlternation(pattern)) {
+            int i = 1;
+            for (; i < pattern.size() && !metaCharacters.contains(pattern.at(i)); i++)
+                prefix.append(pattern.at(i));
+            // the last literal is optional when a quantifier follows it
+            if (i < pattern.size() && quantifiers.contains(pattern.at(i)))
+                prefix.chop(1);
+        }
+        titleAnnotationRx.append(QRegExp(pattern));
+        titleAnnotationPrefix.append(prefix);
+    }
+}
+
+/*
+ * Return true and the title annotation, spaces removed, of the first
+ * pattern that matches title. Results are remembered per part and title.
+ */
+bool Annotations::titleAnnotation(const QString &part, const QString &title, QString &annotation)
+{
+    annotation.clear();
+
+    if (titleAnnotationRx.size() != titleAnnotations.size())
+        compileTitleAnnotations();
+
+    const QString key = QString("%1|%2").arg(part.toLower(), title);
+
+    if (titleAnnotationMisses.contains(key))
+        return false;
+
+    QHash<QString, QString>::const_iterator it = titleAnnotationMatches.constFind(key);
+    if (it != titleAnnotationMatches.constEnd()) {
+        annotation = it.value();
+        return true;
+    }
+
+    for (int i = 0; i < titleAnnotationRx.size(); i++) {
+        const QString &prefix = titleAnnotationPrefix.at(i);
+        if (!prefix.isEmpty() && !title.startsWith(prefix))
+            continue;
+        QRegExp &rx = titleAnnotationRx[i];
+        if (title.contains(rx)) {
+            annotation = rx.cap(1);
+            annotation.remove(QRegExp("\\s"));            //remove spaces
+            titleAnnotationMatches.insert(key, annotation);
+            return true;
+        }
+    }
+
+    titleAnnotationMisses.insert(key);
+    return false;
+}
+
 const int &Annotations::getAnnotationStyle(QString part)
 {
     returnInt = 0;
@@ -1917,50 +1991,80 @@ const QString &Annotations::getStyleAnnotation(QString part)
     return returnString;
 }
 
+// look up key first + second in the compiled BrickLink codes or the parsed rows
+bool Annotations::blCodesValue(const QString &first, const QString &second, int which, QString &value)
+{
+    const ReferenceTable &table = referenceTables[BLCodesTable];
+    if (table.isOpen()) {
+        const int row = table.find(first, second);
+        if (row < 0)
+            return false;
+        value = table.value(row, which);
+        return true;
+    }
+
+    QHash<QString, QStringList>::const_iterator it = blCodes.constFind(QString(first+second).toLower());
+    if (it == blCodes.constEnd() || which >= it.value().size())
+        return false;
+    value = it.value().at(which);
+    return true;
+}
+
+bool Annotations::userElementsValue(const QString &first, const QString &second, QString &value)
+{
+    const ReferenceTable &table = referenceTables[UserElementsTable];
+    if (table.isOpen()) {
+        const int row = table.find(first, second);
+        if (row < 0)
+            return false;
+        value = table.value(row);
+        return true;
+    }
+
+    QHash<QString, QString>::const_iterator it = userElements.constFind(QString(first+second).toLower());
+    if (it == userElements.constEnd())
+        return false;
+    value = it.value();
+    return true;
+}
+
 const QString &Annotations::getBLElement(const QString &ldcolorid, const QString &ldpartid, int which)
 {
-    QString blcolorid,elementkey;
-    if (ld2blColorsXRef.contains(ldcolorid))
-        blcolorid = ld2blColorsXRef[ldcolorid];
-    if (!blcolorid.isEmpty()) {
+    QString blcolorid,blitemid;
+    if (xrefValue(LD2BLColorsXRefTable, ldcolorid, blcolorid) && !blcolorid.isEmpty()) {
         loadBLCodes();
-        elementkey = QString(ldpartid+blcolorid).toLower();
-        if (blCodes.contains(elementkey))
-            return blCodes[elementkey][which];
+        if (blCodesValue(ldpartid, blcolorid, which, returnString))
+            return returnString;
         else
-        if (ld2blCodesXRef.contains(ldpartid)) {
-            elementkey = QString(ld2blCodesXRef[ldpartid.toLower()]+blcolorid).toLower();
-            if (blCodes.contains(elementkey))
-                return blCodes[elementkey][which];
+        if (xrefValue(LD2BLCodesXRefTable, ldpartid, blitemid)) {
+            if (blCodesValue(blitemid, blcolorid, which, returnString))
+                return returnString;
         }
     }
+    returnString.clear();
     return returnString;
 }
 
 //key: ldpartid+ldcolorid
 const QString &Annotations::getUserElement(const QString &ldpartid, const QString &ldcolorid, bool useLDrawKey)
 {
-    QString blcolorid,elementkey;
+    QString blcolorid,blitemid;
     loadUserElements(useLDrawKey);
     if (useLDrawKey) {
-        elementkey = QString(ldpartid+ldcolorid).toLower();
-        if (userElements.contains(elementkey))
-            return userElements[elementkey];
+        if (userElementsValue(ldpartid, ldcolorid, returnString))
+            return returnString;
     } else {
-        if (ld2blColorsXRef.contains(ldcolorid))
-            blcolorid = ld2blColorsXRef[ldcolorid];
-        if (!blcolorid.isEmpty()) {
-            elementkey = QString(ldpartid+blcolorid).toLower();
-            if (userElements.contains(elementkey))
-                return userElements[elementkey];
+        if (xrefValue(LD2BLColorsXRefTable, ldcolorid, blcolorid) && !blcolorid.isEmpty()) {
+            if (userElementsValue(ldpartid, blcolorid, returnString))
+                return returnString;
             else
-            if (ld2blCodesXRef.contains(ldpartid)) {
-                elementkey = QString(ld2blCodesXRef[ldpartid]+blcolorid).toLower();
-                if (userElements.contains(elementkey))
-                    return userElements[elementkey];
+            if (xrefValue(LD2BLCodesXRefTable, ldpartid, blitemid)) {
+                if (userElementsValue(blitemid, blcolorid, returnString))
+                    return returnString;
             }
         }
     }
+    returnString.clear();
     return returnString;
 }
 
@@ -1975,30 +2079,32 @@ const QString &Annotations::getBLColorID(const QString &blcolorname)
 const int &Annotations::getRBColorID(const QString &ldcolorid)
 {
     returnInt = -1;
-    if (ld2rbColorsXRef.contains(ldcolorid.toLower()))
-        returnInt = ld2rbColorsXRef[ldcolorid.toLower()].toInt();
+    QString rbcolorid;
+    if (xrefValue(LD2RBColorsXRefTable, ldcolorid, rbcolorid))
+        returnInt = rbcolorid.toInt();
     return returnInt;
 }
 
 const QString &Annotations::getBrickLinkPartId(const QString &ldpartid)
 {
-    returnString = ldpartid;
-    if (ld2blCodesXRef.contains(ldpartid.toLower()))
-        returnString = ld2blCodesXRef[ldpartid.toLower()];
+    if (!xrefValue(LD2BLCodesXRefTable, ldpartid, returnString))
+        returnString = ldpartid;
     return returnString;
 }
 
 const int &Annotations::getBrickLinkColor(int ldcolorid) {
     returnInt = 0;
-    if (ld2blColorsXRef.contains(QString::number(ldcolorid)))
-        returnInt = ld2blColorsXRef[QString::number(ldcolorid)].toInt();
+    QString blcolorid;
+    if (xrefValue(LD2BLColorsXRefTable, QString::number(ldcolorid), blcolorid))
+        returnInt = blcolorid.toInt();
     return returnInt;
 }
 
 const QString &Annotations::getRBPartID(const QString &ldpartid)
 {
-    if (ld2rbCodesXRef.contains(ldpartid.toLower()))
-        returnString = ld2rbCodesXRef[ldpartid.toLower()];
+    QString rbitemid;
+    if (xrefValue(LD2RBCodesXRefTable, ldpartid, rbitemid))
+        returnString = rbitemid;
     return returnString;
 }
 
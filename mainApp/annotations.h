@@ -16,9 +16,12 @@
 #define ANNOTATIONS_H
 
 #include <QHash>
+#include <QSet>
 #include <QString>
 #include <QStringList>
+#include <QRegExp>
 #include "where.h"
+#include "referencetable.h"
 
 class Annotations {
   private:
@@ -28,6 +31,11 @@ class Annotations {
     static QHash<QString, QString>     freeformAnnotations;
     static QHash<QString, QStringList> annotationStyles;
 
+    static QList<QRegExp>              titleAnnotationRx;      // title annotation patterns compiled once
+    static QStringList                 titleAnnotationPrefix;  // literal title prefix of each pattern
+    static QHash<QString, QString>     titleAnnotationMatches; // matched annotation keyed on part type and title
+    static QSet<QString>               titleAnnotationMisses;  // part type and title without annotation
+
     static QHash<QString, QStringList> blCodes;
     static QHash<QString, QString>     userElements;
     static QHash<QString, QString>     blColors;
@@ -37,9 +45,30 @@ class Annotations {
     static QHash<QString, QString>     ld2rbColorsXRef;
     static QHash<QString, QString>     ld2rbCodesXRef;
     static QList<Where>                AnnotationErrors;
+
+    enum ReferenceTableType {
+        LD2BLColorsXRefTable,
+        LD2BLCodesXRefTable,
+        LD2RBColorsXRefTable,
+        LD2RBCodesXRefTable,
+        BLCodesTable,
+        UserElementsTable,
+        NumReferenceTables
+    };
+    static ReferenceTable              referenceTables[NumReferenceTables];
+
+    static QString referenceTablePath(ReferenceTableType type);
+    static QHash<QString, QString> &xrefHash(ReferenceTableType type);
+    static void compileReferenceTable(ReferenceTableType type, const QByteArray &stamp, const QHash<QString, QStringList> &rows, int columns);
+    static bool loadXRef(ReferenceTableType type);
+    static bool xrefValue(ReferenceTableType type, const QString &key, QString &value);
+    static bool blCodesValue(const QString &first, const QString &second, int which, QString &value);
+    static bool userElementsValue(const QString &first, const QString &second, QString &value);
   public:
     Annotations();
     static const QString &freeformAnnotation(QString part);
+    static bool titleAnnotation(const QString &part, const QString &title, QString &annotation);
+    static void compileTitleAnnotations();
     static const int &getAnnotationStyle(QString part);
     static const int &getAnnotationCategory(QString part);
     static const QString &getStyleAnnotation(QString part);
@@ -22,6 +22,7 @@
 #include "lpub.h"
 #include "lpub_object.h"
 #include "resolution.h"
+#include "ldrawcolourparts.h"
 
 #include "updatecheck.h"
 #include "QsLogDest.h"
@@ -321,8 +322,31 @@
   }
 #else
 #include <time.h> // This is used to get the sleep struct timespec type.
+#include <sys/resource.h>
 #endif
 
+// Process CPU time, user and system, in milliseconds
+static qint64 processCpuTime()
+{
+#ifdef Q_OS_WIN
+  FILETIME creationTime, exitTime, kernelTime, userTime;
+  if (!GetProcessTimes(GetCurrentProcess(), &creationTime, &exitTime, &kernelTime, &userTime))
+    return 0;
+  ULARGE_INTEGER kernel, user;
+  kernel.LowPart  = kernelTime.dwLowDateTime;
+  kernel.HighPart = kernelTime.dwHighDateTime;
+  user.LowPart    = userTime.dwLowDateTime;
+  user.HighPart   = userTime.dwHighDateTime;
+  return qint64((kernel.QuadPart + user.QuadPart) / 10000);
+#else
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0)
+    return 0;
+  return qint64(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * 1000 +
+         qint64(usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1000;
+#endif
+}
+
 // Initializes the Application instance as null
 Application* Application::m_instance = nullptr;
 
@@ -356,6 +380,58 @@ QString Application::getTheme()
     return m_current_theme;
 }
 
+/*
+ * Close the current startup phase and open the next one. Phases are
+ * named from the splash messages without the percent prefix.
+ */
+void Application::startupPhase(const QString &phase)
+{
+  if (!m_startup_timer.isValid())
+    return;
+
+  const qint64 wallTime = m_startup_timer.elapsed();
+  const qint64 cpuTime = processCpuTime();
+
+  if (!m_startup_phase.isEmpty())
+    m_startup_phases.append({ m_startup_phase, wallTime - m_startup_phase_wall, cpuTime - m_startup_phase_cpu });
+
+  QString name = phase.trimmed();
+  const int percent = name.indexOf(QLatin1String("% - "));
+  if (percent > 0 && percent < 4)
+    name = name.mid(percent + 4);
+  while (name.endsWith(QLatin1Char('.')))
+    name.chop(1);
+
+  m_startup_phase = name;
+  m_startup_phase_wall = wallTime;
+  m_startup_phase_cpu = cpuTime;
+}
+
+void Application::startupReport()
+{
+  if (!m_startup_timer.isValid())
+    return;
+
+  startupPhase(QString());
+
+  QStringList report;
+  report << tr("Startup phases (wall ms, CPU ms):");
+  for (const StartupPhase &phase : m_startup_phases)
+    report << QString("  %1 %2  %3").arg(phase.wallTime, 7).arg(phase.cpuTime, 7).arg(phase.name);
+  report << tr("  %1 %2  Total startup").arg(m_startup_phase_wall, 7).arg(m_startup_phase_cpu, 7);
+
+  if (m_console_mode) {
+    Preferences::printInfo(report.join(QLatin1Char('\n')));
+  } else {
+    Preferences::setMessageLogging(DEFAULT_LOG_LEVEL);
+    logInfo() << qUtf8Printable(report.join(QLatin1Char('\n')));
+    Preferences::setMessageLogging();
+  }
+
+  m_startup_phases.clear();
+  m_startup_timer.invalidate();
+}
+
 void Application::setTheme(bool appStarted /*true*/)
 {
   m_current_theme = Preferences::displayTheme;
@@ -645,6 +721,7 @@ void Application::setTheme(bool appStarted /*true*/)
 
 void Application::splashMsg(const QString &message)
 {
+  startupPhase(message);
   Preferences::setMessageLogging(DEFAULT_LOG_LEVEL);
   logInfo() << qUtf8Printable(message);
   Preferences::setMessageLogging();
@@ -659,6 +736,11 @@ int Application::initialize(lcCommandLineOptions &Options)
 #ifdef Q_OS_MAC
     m_application.setStyle(QStyleFactory::create("macintosh"));
 #endif
+    m_startup_timer.start();
+    m_startup_phase = tr("Command line processing");
+    m_startup_phase_wall = 0;
+    m_startup_phase_cpu = processCpuTime();
+
     m_application_restart = false;
     m_console_mode = false;
     m_print_output = false;
@@ -1266,10 +1348,18 @@ QString distribution = tr("Installed");
     // Set global Visual Editor shared OpenGL context
     if (!lcContext::InitializeRenderer())
     {
-        gApplication->Shutdown();
-        const QString message = tr("Error creating shared OpenGL context. (return code 1)");
-        Preferences::printInfo(message,true);
-        throw InitException(qPrintable(message));
+        // Console native renders can rasterize on the CPU without a context
+        if (!modeGUI() && Preferences::preferredRenderer == RENDERER_NATIVE)
+        {
+            Preferences::printInfo(tr("OpenGL context is not available. Native renders will use the software renderer."));
+        }
+        else
+        {
+            gApplication->Shutdown();
+            const QString message = tr("Error creating shared OpenGL context. (return code 1)");
+            Preferences::printInfo(message,true);
+            throw InitException(qPrintable(message));
+        }
     }
 
     emit splashMsgSig(tr("25% - %1 GUI window loading...").arg(VER_PRODUCTNAME_STR));
@@ -1289,6 +1379,10 @@ QString distribution = tr("Installed");
 
     emit splashMsgSig(tr("40% - Visual Editor initialization..."));
 
+    // read the color parts list while the parts library loads
+    if (Preferences::enableFadeSteps || Preferences::enableHighlightStep)
+        LDrawColourParts::LDrawColorPartsPrefetch();
+
     if (gApplication->Initialize(LibraryPaths, gui) == lcStartupMode::Error) {
         gApplication->Shutdown();
         const QString message = tr("Unable to initialize Visual Editor. (return code 1)");
@@ -1309,7 +1403,8 @@ void Application::mainApp()
     emit splashMsgSig(tr("100% - %1 loaded.").arg(VER_PRODUCTNAME_STR));
 
 #ifndef DISABLE_UPDATE_CHECK
-    if (m_enable_update_check)
+    // available versions are only shown in the GUI preferences dialog
+    if (m_enable_update_check && modeGUI())
         availableVersions = new AvailableVersions(this);
 #endif
 
@@ -1328,6 +1423,8 @@ void Application::mainApp()
         QWindowsWindowFunctions::setHasBorderInFullScreen(gui->windowHandle(), true);
 #endif
 #endif
+        startupReport();
+
         Gui::setLoadLastDisplayedPage(m_application_restart);
 
         if (!m_commandline_file.isEmpty())
@@ -1340,6 +1437,8 @@ void Application::mainApp()
             DoInitialUpdateCheck();
 #endif
 
+    } else {
+        startupReport();
     }
 }
 
@@ -1389,6 +1488,9 @@ int Application::run()
 
 void Application::shutdown()
 {
+    if (Preferences::loggingEnabled)
+        logInfo() << qUtf8Printable(QsLogging::Logger::instance().writeStatistics());
+
     delete gui;
     gui = nullptr;
 
@@ -1419,6 +1521,29 @@ static void initializeSurfaceFormat(int argc, char* argv[], lcCommandLineOptions
     }
 }
 
+static void initializeHeadlessPlatform(int argc, char* argv[])
+{
+#ifdef Q_OS_LINUX
+    // Command line exports on hosts without a display server use the
+    // offscreen platform. Qt::AA_UseSoftwareOpenGL only applies on Windows,
+    // so OpenGL availability here depends on the offscreen plugin build.
+    // Without it, native renders use the software renderer.
+    bool consoleMode = false;
+    for (int i = 1; i < argc && !consoleMode; i++)
+        consoleMode = argv[i][0] == '-';
+
+    if (consoleMode &&
+        qEnvironmentVariableIsEmpty("DISPLAY") &&
+        qEnvironmentVariableIsEmpty("WAYLAND_DISPLAY") &&
+        qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+#else
+    Q_UNUSED(argc)
+    Q_UNUSED(argv)
+#endif
+}
+
 #if defined AUTO_RESTART && AUTO_RESTART == 1
 static int lpub3dMain(int &argc, char **argv)
 #else
@@ -1431,6 +1556,8 @@ int main(int argc, char** argv)
 
     lcCommandLineOptions Options;
 
+    initializeHeadlessPlatform(argc, argv);
+
     initializeSurfaceFormat(argc, argv, Options);
 
     QCoreApplication::setAttribute(Qt::AA_ShareOpenGLContexts);
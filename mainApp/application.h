@@ -20,6 +20,9 @@
 #include <Windows.h>
 #endif
 
+#include <QElapsedTimer>
+#include <QVector>
+
 #include "lc_global.h"
 #include "lc_math.h"
 #include "declarations.h"
@@ -73,6 +76,12 @@ public:
     /// Gets the theme
     QString getTheme();
 
+    /// Start the next traced startup phase
+    void startupPhase(const QString &phase);
+
+    /// Print and log the wall and CPU time of each startup phase
+    void startupReport();
+
 #ifdef Q_OS_WIN
     /// Console redirection for Windows
     void RedirectIOToConsole();
@@ -121,6 +130,21 @@ private:
     /// File specified on via commandline
     QString m_commandline_file;
 
+    /// Startup phase trace entry
+    struct StartupPhase
+    {
+        QString name;
+        qint64 wallTime;
+        qint64 cpuTime;
+    };
+
+    /// Startup phase trace
+    QElapsedTimer m_startup_timer;
+    QVector<StartupPhase> m_startup_phases;
+    QString m_startup_phase;
+    qint64 m_startup_phase_wall;
+    qint64 m_startup_phase_cpu;
+
     /// Theme set at startup
 	QString m_current_theme;
 
@@ -16,15 +16,76 @@
 #include <quazipfile.h>
 #include <quazipdir.h>
 #include <QsLog.h>
+#include <QSet>
+#include <QtConcurrent>
+#include <cstring>
 
 #include "archiveparts.h"
 #include "lpub_preferences.h"
 #include "lpub.h"
 
+// number of entries compressed in memory before they are appended to the archive
+static const int ArchiveBatchSize = 256;
+
 ArchiveParts::ArchiveParts(QObject *parent) : QObject(parent)
 {
 }
 
+// file systems on Windows and macOS compare names without case
+QString ArchiveParts::ArchiveKey(const QString &filePath)
+{
+#if defined(Q_OS_WIN) || defined(Q_OS_MAC)
+  return QDir::cleanPath(QFileInfo(filePath).absoluteFilePath()).toLower();
+#else
+  return QDir::cleanPath(QFileInfo(filePath).absoluteFilePath());
+#endif
+}
+
+/*
+ * Read the entry file and deflate it into memory as a raw stream,
+ * ready to be appended to the archive without compression.
+ * Runs on a worker thread.
+ */
+ArchiveParts::ArchiveEntry ArchiveParts::CompressEntry(const ArchiveEntry &entry)
+{
+  ArchiveEntry compressed = entry;
+
+  QFile inFile(entry.filePath);
+  if (!inFile.open(QIODevice::ReadOnly)) {
+      compressed.error = tr("inFile open error: %1").arg(inFile.errorString());
+      return compressed;
+  }
+  const QByteArray data = inFile.readAll();
+  inFile.close();
+
+  compressed.size = data.size();
+  compressed.crc = quint32(crc32(crc32(0L, Z_NULL, 0), reinterpret_cast<const Bytef *>(data.constData()), uInt(data.size())));
+
+  z_stream stream;
+  memset(&stream, 0, sizeof(stream));
+  if (deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -MAX_WBITS, DEF_MEM_LEVEL, Z_DEFAULT_STRATEGY) != Z_OK) {
+      compressed.error = tr("Could not initialize compression for %1.").arg(entry.filePath);
+      return compressed;
+  }
+
+  compressed.data.resize(int(deflateBound(&stream, uLong(data.size()))));
+  stream.next_in   = reinterpret_cast<Bytef *>(const_cast<char *>(data.constData()));
+  stream.avail_in  = uInt(data.size());
+  stream.next_out  = reinterpret_cast<Bytef *>(compressed.data.data());
+  stream.avail_out = uInt(compressed.data.size());
+
+  const int status = deflate(&stream, Z_FINISH);
+  compressed.data.resize(int(stream.total_out));
+  deflateEnd(&stream);
+
+  if (status != Z_STREAM_END) {
+      compressed.data.clear();
+      compressed.error = tr("Could not compress %1. Return code %2.").arg(entry.filePath).arg(status);
+  }
+
+  return compressed;
+}
+
 /*
  * Insert static coloured fade parts into unofficial ldraw library
  *
@@ -80,7 +141,7 @@ bool ArchiveParts::Archive(
   QuaZip zip(zipArchive);
   zip.setFileNameCodec("IBM866");
 
-  QFileInfoList zipFiles;
+  QSet<QString> zipFiles;
 
   if (zipFileInfo.exists()) {
       if (!zip.open(QuaZip::mdAdd)) {
@@ -127,8 +188,9 @@ bool ArchiveParts::Archive(
 
       emit gui->messageSig(LOG_DEBUG, tr("Get Existing Archive File List %1").arg(Gui::elapsedTime(t.elapsed())));
 
-      //Create an array of archive file QFileInfo objects
-      Q_FOREACH (QString const &zipFile, zipFileList) zipFiles << QFileInfo(zipFile);
+      // Index the existing archive files
+      zipFiles.reserve(zipFileList.size());
+      Q_FOREACH (QString const &zipFile, zipFileList) zipFiles.insert(ArchiveKey(zipFile));
 
   } else {
       if (!zip.open(QuaZip::mdCreate)) {
@@ -138,40 +200,29 @@ bool ArchiveParts::Archive(
   }
 
   // Initialize some variables
-  QFile inFile;
-  QuaZipFile outFile(&zip);
+  QList<ArchiveEntry> entries;
   int archivedPartCount   = 0;
 
-  char c;
   Q_FOREACH (QFileInfo const &fileInfo, filesToArchive) {
 
       //qDebug() << "Processing Disk File Name: " << fileInfo.absoluteFilePath();
       if (!fileInfo.isFile())
         continue;
 
-      bool alreadyArchived = false;
       QString partStatus = "Archiving";
 
-      Q_FOREACH (QFileInfo const &zipFileInfo, zipFiles) {
-          if (fileInfo == zipFileInfo) {
-              bool okToOverwrite = (zipFileInfo.fileName().endsWith(QString("%1.dat").arg(QLatin1String(FADE_SFX)),Qt::CaseInsensitive) ||
-                                    zipFileInfo.fileName().endsWith(QString("%1.dat").arg(QLatin1String(HIGHLIGHT_SFX)),Qt::CaseInsensitive));
-              if (overwriteCustomPart && okToOverwrite) {
-                  partStatus = "Overwriting archive";
-                  //qDebug() << "FileMatch - Overwriting Fade File !! " << fileInfo.absoluteFilePath();
-              } else {
-                  alreadyArchived = true;
-                  //qDebug() << "FileMatch - Skipping !! " << fileInfo.absoluteFilePath();
-              }
-              break;
+      if (zipFiles.contains(ArchiveKey(fileInfo.absoluteFilePath()))) {
+          bool okToOverwrite = (fileInfo.fileName().endsWith(QString("%1.dat").arg(QLatin1String(FADE_SFX)),Qt::CaseInsensitive) ||
+                                fileInfo.fileName().endsWith(QString("%1.dat").arg(QLatin1String(HIGHLIGHT_SFX)),Qt::CaseInsensitive));
+          if (overwriteCustomPart && okToOverwrite) {
+              partStatus = "Overwriting archive";
+              //qDebug() << "FileMatch - Overwriting Fade File !! " << fileInfo.absoluteFilePath();
+          } else {
+              //qDebug() << "FileMatch - Skipping !! " << fileInfo.absoluteFilePath();
+              continue;
           }
       }
 
-      if (alreadyArchived)
-        continue;
-      else
-         archivedPartCount++;
-
       // place archive file in appropriate archive subfolder
       QString fileNameWithRelativePath;
 
@@ -210,40 +261,71 @@ bool ArchiveParts::Archive(
           //qDebug() << "fileNameWithCompletePath (PART - DEFAULT)" << fileNameWithCompletePath;
         }
 
-      emit gui->messageSig(LOG_INFO, QString("%1 part #%2 %3 to %4...")
-                                             .arg(partStatus).arg(archivedPartCount)
-                                             .arg(fileInfo.fileName()).arg(fileNameWithCompletePath));
+      ArchiveEntry entry;
+      entry.filePath    = fileInfo.filePath();
+      entry.archivePath = fileNameWithCompletePath;
+      entry.status      = partStatus;
+      entries << entry;
+    }
 
-      // insert file into archive
-      inFile.setFileName(fileInfo.filePath());
+  if (m_reportProgress)
+    emit progressRangeSig(0, entries.size());
 
-      if (!inFile.open(QIODevice::ReadOnly)) {
-          result = tr("inFile open error: %1").arg(inFile.errorString().toLocal8Bit().constData());
-          return false;
-      }
+  QElapsedTimer t; t.start();
 
-      if (!outFile.open(QIODevice::WriteOnly, QuaZipNewInfo(fileNameWithCompletePath, fileInfo.filePath()))) {
-          result = tr("outFile open error. Return code %1.").arg(outFile.getZipError());
-          return false;
-        }
+  // compress each batch of entries in parallel then append them in order
+  QuaZipFile outFile(&zip);
 
-      while (inFile.getChar(&c) && outFile.putChar(c));
+  for (int batch = 0; batch < entries.size(); batch += ArchiveBatchSize) {
 
-      if (outFile.getZipError() != UNZ_OK) {
-          result = tr("outFile error. Return code %1.").arg(outFile.getZipError());
-          return false;
-        }
+      const QList<ArchiveEntry> compressedEntries =
+          QtConcurrent::blockingMapped<QList<ArchiveEntry> >(entries.mid(batch, ArchiveBatchSize), &ArchiveParts::CompressEntry);
 
-      outFile.close();
+      Q_FOREACH (ArchiveEntry const &entry, compressedEntries) {
 
-      if (outFile.getZipError() != UNZ_OK) {
-          result = tr("outFile close error. Return code %1.").arg(outFile.getZipError());
-          return false;
-        }
+          archivedPartCount++;
 
-      inFile.close();
+          emit gui->messageSig(LOG_INFO, QString("%1 part #%2 %3 to %4...")
+                                                 .arg(entry.status).arg(archivedPartCount)
+                                                 .arg(QFileInfo(entry.filePath).fileName()).arg(entry.archivePath));
+
+          if (!entry.error.isEmpty()) {
+              result = entry.error;
+              return false;
+          }
+
+          // insert the compressed file into archive
+          QuaZipNewInfo newInfo(entry.archivePath, entry.filePath);
+          newInfo.uncompressedSize = ulong(entry.size);
+
+          if (!outFile.open(QIODevice::WriteOnly, newInfo, nullptr, entry.crc, Z_DEFLATED, Z_DEFAULT_COMPRESSION, true/*raw*/)) {
+              result = tr("outFile open error. Return code %1.").arg(outFile.getZipError());
+              return false;
+            }
+
+          outFile.write(entry.data);
+
+          if (outFile.getZipError() != UNZ_OK) {
+              result = tr("outFile error. Return code %1.").arg(outFile.getZipError());
+              return false;
+            }
+
+          outFile.close();
+
+          if (outFile.getZipError() != UNZ_OK) {
+              result = tr("outFile close error. Return code %1.").arg(outFile.getZipError());
+              return false;
+            }
+
+          if (m_reportProgress)
+            emit progressSetValueSig(archivedPartCount);
+        }
     }
 
+  if (archivedPartCount)
+    emit gui->messageSig(LOG_DEBUG, tr("Compressed and appended %1 archive entries %2")
+                                       .arg(archivedPartCount).arg(Gui::elapsedTime(t.elapsed())));
+
   if (!comment.isEmpty())
     zip.setComment(comment);
 
@@ -16,6 +16,7 @@
 #define ARCHIVEPARTS_H
 
 #include <QObject>
+#include <QByteArray>
 
 class QDir;
 
@@ -26,7 +27,7 @@ class ArchiveParts : public QObject
 public:
   explicit ArchiveParts(QObject *parent = 0);
   ~ArchiveParts() {}
-  static bool Archive(
+  bool Archive(
       const QString &zipArchive,
       const QDir &dir,
             QString &result,
@@ -45,9 +46,37 @@ public:
             QStringList &validDirFiles,
             const QString &zipArchive);
 
+    void setReportProgress(bool reportProgress)
+    {
+      m_reportProgress = reportProgress;
+    }
+
 public slots:
 
 signals:
+     void progressRangeSig(
+             const int          &min,
+             const int          &max);
+
+     void progressSetValueSig(
+             const int          &value);
+
+private:
+    struct ArchiveEntry
+    {
+      QString filePath;
+      QString archivePath;
+      QString status;
+      QByteArray data;      // raw deflate stream
+      qint64 size = 0;      // uncompressed size
+      quint32 crc = 0;
+      QString error;
+    };
+
+    static ArchiveEntry CompressEntry(const ArchiveEntry &entry);
+    static QString ArchiveKey(const QString &filePath);
+
+    bool m_reportProgress = false;
 };
 
 #endif // ARCHIVEPARTS_H
@@ -986,6 +986,8 @@ enum ThemeColorType {
 
 #define PAGE_CYCLE_DISPLAY_DEFAULT              1    // measured in seconds
 #define PAGE_DISPLAY_PAUSE_DEFAULT              3    // measured in seconds
+#define IMAGE_CACHE_SIZE_DEFAULT              256    // decoded image cache size in MB
+#define IMAGE_CACHE_PAGE_RANGE_DEFAULT          8    // pages before and after the displayed page with recorded images
 #define MAX_OPEN_WITH_PROGRAMS_DEFAULT          3    // maximum open with programs entries
 #define MESSAGE_LINE_WIDTH_DEFAULT             80    // default width of message line in characters
 // Internal common material colours
@@ -306,6 +306,8 @@ void DialogExportPages::getPixelRatioMsg(double value)
     ui->checkBoxPdfPageImage->setVisible(Gui::m_exportMode == EXPORT_PDF);
     ui->checkBoxPdfPageImage->setChecked(Preferences::pdfPageImage || value > 1.0 || value < 1.0);
     ui->checkBoxPdfPageImage->setEnabled(value == 1.0);
+    ui->checkBoxPdfPageImageLossless->setVisible(Gui::m_exportMode == EXPORT_PDF);
+    ui->checkBoxPdfPageImageLossless->setChecked(Preferences::pdfPageImageLossless);
 }
 
 QString const DialogExportPages::pageRangeText() {
@@ -350,6 +352,11 @@ bool DialogExportPages::pdfPageImage()
     return ui->checkBoxPdfPageImage->isChecked() && ok;
 }
 
+bool DialogExportPages::pdfPageImageLossless()
+{
+    return ui->checkBoxPdfPageImageLossless->isChecked();
+}
+
 qreal DialogExportPages::exportPixelRatio() {
     return ui->spinPixelRatio->value();
 }
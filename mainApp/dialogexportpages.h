@@ -38,6 +38,7 @@ public:
   bool ignoreMixedPageSizesMsg();
   bool doNotShowPageProcessDlg();
   bool pdfPageImage();
+  bool pdfPageImageLossless();
   int pageDisplayPause();
   void groupBoxPixelRatio(bool);
   qreal exportPixelRatio();
@@ -102,7 +102,7 @@ EditWindow *cmdEditor;
 EditWindow *cmdModEditor;
 
 EditWindow::EditWindow(QMainWindow *parent, bool _modelFileEdit_) :
-  QMainWindow(parent),isIncludeFile(false),_modelFileEdit(_modelFileEdit_),_pageIndx(0)
+  QMainWindow(parent),isIncludeFile(false),_modelFileEdit(_modelFileEdit_),_pageFile(nullptr),_pageIndx(0)
 {
     qRegisterMetaType<CurrentStepType>("CurrentStepType");
     qRegisterMetaType<DecorationType>("DecorationType");
@@ -238,10 +238,15 @@ void EditWindow::setSelectionHighlighter()
 
 void EditWindow::setTextEditHighlighter()
 {
-    if (Preferences::editorDecoration == SIMPLE_DECORATION)
+    highlighter = nullptr;
+    highlighterSimple = nullptr;
+
+    if (Preferences::editorDecoration == SIMPLE_DECORATION) {
       highlighterSimple = new HighlighterSimple(_textEdit->document());
-    else
+    } else {
       highlighter = new Highlighter(_textEdit->document());
+      highlighter->setTextEdit(_textEdit);
+    }
 
     setSelectionHighlighter();
 }
@@ -1694,14 +1699,20 @@ void EditWindow::contentsChange(
   QString addedChars,removedChars;
 
   if (charsAdded || charsRemoved) {
-    addedChars = _textEdit->toPlainText();
+    QTextDocument *document = _textEdit->document();
 
-    if (addedChars.size() == 0)
+    if (document->isEmpty())
       return;
 
-    addedChars = addedChars.mid(position,charsAdded);
-    removedChars = lpub->ldrawFile.contents(fileName).join("\n");
-    removedChars = removedChars.mid(position,charsRemoved);
+    // read only the changed range - not the whole document and model file
+    QTextCursor cursor(document);
+    cursor.setPosition(qMin(position, document->characterCount() - 1));
+    cursor.setPosition(qMin(position + charsAdded, document->characterCount() - 1), QTextCursor::KeepAnchor);
+    addedChars = cursor.selectedText();
+    addedChars.replace(QChar::ParagraphSeparator, QLatin1Char('\n'));
+    addedChars.replace(QChar::Nbsp, QLatin1Char(' '));
+
+    removedChars = lpub->ldrawFile.contentsRange(fileName, position, charsRemoved);
     contentsChanged = addedChars != removedChars;
 
     if (!contentsChanged)
@@ -2612,6 +2623,8 @@ void EditWindow::setPlainText(const QString &content)
                                .arg(lineCount)
                                .arg(content.count(QRegExp("\\r\\n?|\\n")) + 1));
 #endif
+    if (highlighter)
+        highlighter->deferHighlighting(lineCount);
     _textEdit->setPlainText(content);
 }
 
@@ -2655,6 +2668,7 @@ void EditWindow::displayFile(
   fileName        = _fileName;
   lineCount       = 0;
   _pageIndx       = 0;
+  _pageFile       = nullptr;
   _contentLoaded  = false;
   _waitingSpinner = nullptr;
   displayTimer.start();
@@ -2722,7 +2736,9 @@ void EditWindow::displayFile(
 #ifdef QT_DEBUG_MODE
       emit lpub->messageSig(LOG_DEBUG,QString("3. Editor Load Paged Text Started..."));
 #endif
-      _pageContent = ldrawFile->contents(fileName);
+      // read pages from the model file as they are needed instead of a copy
+      _pageContent.clear();
+      _pageFile = ldrawFile;
 
       loadPagedContent();
 
@@ -2732,6 +2748,8 @@ void EditWindow::displayFile(
 #endif
       // loadContentBlocks(ldrawFile->contents(fileName),true/ *initial load* /);
 
+      if (highlighter)
+          highlighter->deferHighlighting(lineCount);
       _textEdit->setPlainText(ldrawFile->contents(fileName).join("\n"));
     }
 
@@ -3131,6 +3149,7 @@ void EditWindow::preferences()
                 if (highlighter)
                     highlighter = nullptr;
                 highlighter = new Highlighter(_textEdit->document());
+                highlighter->setTextEdit(_textEdit);
                 highlighter->rehighlight();
             }
             Settings.setValue(QString("%1/%2").arg(SETTINGS,"EditorDecoration"),Preferences::editorDecoration);
@@ -3252,16 +3271,19 @@ void EditWindow::loadPagedContent()
    _contentLoading = true;
 
    QElapsedTimer t; t.start();
+
+   const QStringList pageContent = _pageFile ? _pageFile->contents(fileName) : _pageContent;
+
 #ifdef QT_DEBUG_MODE
    emit lpub->messageSig(LOG_DEBUG,tr("Load paged content %1 lines - start...")
-                              .arg(_pageContent.size()));
+                              .arg(pageContent.size()));
 #endif
 
    bool initialLoad   = _textEdit->document()->isEmpty();
    int linesPerPage   = Preferences::editorLinesPerPage - (initialLoad ? 1 : 0);
-   int nextIndx       = qMin(linesPerPage, (_pageContent.size() - _pageIndx) - 1);
+   int nextIndx       = qMin(linesPerPage, (pageContent.size() - _pageIndx) - 1);
    int maxPageIndx    = _pageIndx + nextIndx;
-   const QString page = _pageContent.mid(_pageIndx, nextIndx).join('\n');
+   const QString page = pageContent.mid(_pageIndx, nextIndx).join('\n');
    int pageLineCount  = page.count("\n") + (initialLoad ? 2 : 1);
 
 #ifdef QT_DEBUG_MODE
@@ -3293,13 +3315,13 @@ void EditWindow::loadPagedContent()
    }
 // */
 
-   _contentLoaded = maxPageIndx >= _pageContent.size() - 1;
+   _contentLoaded = maxPageIndx >= pageContent.size() - 1;
 
    emit lpub->messageSig(LOG_TRACE,tr("Load page of %1 lines from %2 to %3, content lines %4, final page: %5 - %6")
                               .arg(pageLineCount)
                               .arg(_pageIndx + 1)
                               .arg(maxPageIndx + 1)
-                              .arg(_pageContent.size())
+                              .arg(pageContent.size())
                               .arg(_contentLoaded ? "Yes" : "No")
                               .arg(LPub::elapsedTime(t.elapsed())));
 
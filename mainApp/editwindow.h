@@ -275,6 +275,7 @@ protected:
     QString            _curSubFile;         // currently displayed submodel
     QStringList        _subFileList;
     QStringList        _pageContent;
+    LDrawFile         *_pageFile;           // paged lines are read from this file when set
     int                _pageIndx;
     int                _saveSubfileIndex;
 
@@ -26,6 +26,7 @@
 #include "QsLog.h"
 
 QList<ExcludedParts::Part> ExcludedParts::excludedParts;
+QHash<QString, int>        ExcludedParts::excludedPartTypes;
 
 ExcludedParts::ExcludedParts()
 {
@@ -75,12 +76,13 @@ ExcludedParts::ExcludedParts()
                               ? EP_LSYNTH
                               : EP_STANDARD;
                     Part excludedPart(rx.cap(1), type);
-                    excludedParts.append(excludedPart);
+                    addExcludedPart(excludedPart);
                     //logDebug() << "** ExcludedPartName: " << excludedPartID.id;
                 }
             }
         } else {
             excludedParts.clear();
+            excludedPartTypes.clear();
             QByteArray Buffer;
             loadExcludedParts(Buffer);
             QTextStream instream(Buffer);
@@ -96,75 +98,72 @@ ExcludedParts::ExcludedParts()
                               ? EP_LSYNTH
                               : EP_STANDARD;
                     Part excludedPart(rx.cap(1), type);
-                    excludedParts.append(excludedPart);
+                    addExcludedPart(excludedPart);
                 }
             }
         }
     }
 }
 
+/*
+ * Index the part by its lower case id. The list keeps the file order,
+ * so the first entry of a part that is listed twice sets its type.
+ */
+void ExcludedParts::addExcludedPart(const Part &part)
+{
+    excludedParts.append(part);
+    const QString id = part.id.toLower();
+    if (!excludedPartTypes.contains(id))
+        excludedPartTypes.insert(id, part.type);
+}
+
 bool ExcludedParts::isExcludedPart(const QString &part, bool &helperPart)
 {
     bool allowHelperPart = helperPart;
     helperPart = false;
-    for (Part &excludedPart : excludedParts) {
-        if (excludedPart.id.toLower() == part.toLower().trimmed()) {
-            if (allowHelperPart)
-                if ((helperPart = excludedPart.type == EP_HELPER))
-                    return false;
-            return true;
-        }
+    QHash<QString, int>::const_iterator i = excludedPartTypes.constFind(part.toLower().trimmed());
+    if (i != excludedPartTypes.constEnd()) {
+        if (allowHelperPart)
+            if ((helperPart = i.value() == EP_HELPER))
+                return false;
+        return true;
     }
     return false;
 }
 
 bool ExcludedParts::isExcludedPart(const QString &part)
 {
-    for (Part &excludedPart : excludedParts) {
-        if (excludedPart.id.toLower() == part.toLower().trimmed()) {
-            return true;
-        }
-    }
-    return false;
+    return excludedPartTypes.contains(part.toLower().trimmed());
 }
 
 int ExcludedParts::isExcludedSupportPart(const QString &part)
 {
-    for (Part &excludedPart : excludedParts) {
-        if (excludedPart.id.toLower() == part.toLower().trimmed()) {
-            return excludedPart.type;
-        }
-    }
-    return EP_STANDARD;
+    return excludedPartTypes.value(part.toLower().trimmed(), EP_STANDARD);
 }
 
 bool ExcludedParts::lineHasExcludedPart(const QString &line)
 {
-    QRegExp typeRx("^([1-5]) ");
-    if (!line.contains(typeRx))
+    if (line.size() < 2 || line.at(0) < QLatin1Char('1') || line.at(0) > QLatin1Char('5') || line.at(1) != QLatin1Char(' '))
         return false;
 
-    QString part;
-    QString type = typeRx.cap(1);
-    QStringList le = line.split(" ", SkipEmptyParts);
-
-    // treat parts with spaces in the name
-    int i = 0;
-    if (le.size() >= 15 && type == "1")
-        i = 14;
-    else if (le.size() >= 14 && type.contains(QRegExp("4|5")))
-        i = 13;
-    else if (le.size() >= 11 && type == "3")
-        i = 10;
-    else if (le.size() >= 8 && type == "2")
-        i = 7;
-    else
+    // minimum token count for each line type, the part name starts at the last token
+    static const int minTokens[] = { 0, 15, 8, 11, 14, 14 };
+    const int partToken = minTokens[line.at(0).digitValue()] - 1;
+
+    // find the start of the part token in one pass, treat parts with spaces in the name
+    int tokens = 0, partStart = -1;
+    for (int i = 0; i < line.size() && partStart < 0; i++) {
+        if (line.at(i) != QLatin1Char(' ') && (i == 0 || line.at(i - 1) == QLatin1Char(' '))) {
+            if (tokens == partToken)
+                partStart = i;
+            tokens++;
+        }
+    }
+    if (partStart < 0)
         return false;
 
-    for (; i < le.size(); i++)
-        part += (le.at(i)+" ");
-
-    return isExcludedPart(part.replace(QRegExp("[\"']"),""));
+    QString part = line.mid(partStart).split(QLatin1Char(' '), SkipEmptyParts).join(QLatin1Char(' '));
+    return isExcludedPart(part.remove(QLatin1Char('"')).remove(QLatin1Char('\'')));
 }
 
 void ExcludedParts::loadExcludedParts(QByteArray &Buffer)
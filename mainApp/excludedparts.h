@@ -16,6 +16,7 @@
 #define EXCLUDEDPARTS_H
 
 #include <QString>
+#include <QHash>
 
 class ExcludedParts
 {
@@ -41,7 +42,9 @@ class ExcludedParts
         Part() : type(EP_STANDARD) {}
         Part(const QString _id, const int _type) : id(_id), type(_type) {}
     };
+    static void addExcludedPart(const Part &part);
     static QList<Part> excludedParts;
+    static QHash<QString, int> excludedPartTypes; // lower case id, first entry wins
 };
 
 #endif // EXCLUDEDPARTS_H
@@ -59,6 +59,7 @@
 #include "calloutpointeritem.h"
 #include "pagepointeritem.h"
 #include "waitingspinnerwidget.h"
+#include "imagecache.h"
 #if (QT_VERSION >= QT_VERSION_CHECK(5, 0, 0))
 #include <QtConcurrent>
 #endif
@@ -1167,7 +1168,7 @@ int Gui::addGraphicsPageItems(
  * Call only if using LDView Single Call (useLDViewsCall=true)
  */
 int Gui::addStepImageGraphics(Step *step) {
-  step->csiPixmap.load(step->pngName);
+  ImageCache::loadPixmap(step->pngName, &step->csiPixmap);
   step->csiPlacement.size[0] = step->csiPixmap.width();
   step->csiPlacement.size[1] = step->csiPixmap.height();
   step->viewerOptions->ImageWidth = step->csiPixmap.width();
@@ -31,9 +31,19 @@
 #include "lpub_preferences.h"
 #include "lpub_qtcompat.h"
 #include "declarations.h"
+#include "QsLog.h"
+
+// files with at least this many lines are highlighted on demand
+static const int HighlighterDeferredLines = 5000;
+// blocks highlighted per event loop pass while idle
+static const int HighlighterIdleBlocks    = 250;
 
 Highlighter::Highlighter(QTextDocument *parent)
-    : QSyntaxHighlighter(parent)
+    : QSyntaxHighlighter(parent),
+      deferred(false),
+      idleBlock(0),
+      visibleFirst(-1),
+      visibleLast(-1)
 {
     HighlightingRule rule;
 
@@ -1053,17 +1063,137 @@ Highlighter::Highlighter(QTextDocument *parent)
     LDrawFileFormat.setForeground(br12);
     LDrawFileFormat.setFontWeight(QFont::Bold);
     lineTypeFormats.append(LDrawFileFormat);
+
+    // rules anchored to the line type, like ^0 and ^2, are only tried on lines of that type
+    for (HighlightingRule &highlightingRule : highlightingRules) {
+        const QString pattern = highlightingRule.pattern.pattern();
+        if (pattern.size() == 2 && pattern.at(0) == QLatin1Char('^') && pattern.at(1).isDigit())
+            highlightingRule.anchor = pattern.at(1);
+    }
+
+    LDrawTexmapExpression = QRegularExpression(QStringLiteral("^0\\s+!?TEXMAP\\s+(?:START|NEXT)"));
+
+    idleTimer.setInterval(0);
+    connect(&idleTimer, &QTimer::timeout, this, &Highlighter::highlightIdleBlocks);
+}
+
+void Highlighter::setTextEdit(QPlainTextEdit *edit)
+{
+    textEdit = edit;
+    if (textEdit)
+        connect(textEdit->verticalScrollBar(), &QScrollBar::valueChanged, this, &Highlighter::highlightVisibleBlocks);
+}
+
+/*
+ * Highlight the next content load of a large file on demand. The visible
+ * blocks are highlighted first and the rest of the document while idle.
+ */
+void Highlighter::deferHighlighting(int lineCount)
+{
+    if (lineCount < HighlighterDeferredLines) {
+        deferred = false;
+        idleTimer.stop();
+        return;
+    }
+
+    deferred     = true;
+    idleBlock    = 0;
+    visibleFirst = -1;
+    visibleLast  = -1;
+    deferredTimer.start();
+
+    QTimer::singleShot(0, this, &Highlighter::highlightVisibleBlocks);
+    idleTimer.start();
+}
+
+void Highlighter::highlightVisibleBlocks()
+{
+    if (!deferred || !textEdit)
+        return;
+
+    const QTextBlock first = textEdit->cursorForPosition(QPoint(0, 0)).block();
+    const QTextBlock last  = textEdit->cursorForPosition(QPoint(0, textEdit->viewport()->height())).block();
+
+    visibleFirst = first.blockNumber();
+    visibleLast  = last.blockNumber();
+
+    for (QTextBlock block = first; block.isValid(); block = block.next()) {
+        const int blockNumber = block.blockNumber();
+        if (blockNumber > visibleLast)
+            break;
+        if (blockNumber >= idleBlock)
+            rehighlightBlock(block);
+    }
+}
+
+void Highlighter::highlightIdleBlocks()
+{
+    QTextBlock block = document() ? document()->findBlockByNumber(idleBlock) : QTextBlock();
+    for (int count = 0; block.isValid() && count < HighlighterIdleBlocks; count++) {
+        const int blockNumber = idleBlock++;
+        if (blockNumber < visibleFirst || blockNumber > visibleLast)
+            rehighlightBlock(block);
+        block = block.next();
+    }
+
+    if (!block.isValid()) {
+        deferred = false;
+        idleTimer.stop();
+        logDebug() << QString("Highlighted %1 lines on demand in %2 ms")
+                              .arg(idleBlock).arg(deferredTimer.elapsed());
+    }
+}
+
+bool Highlighter::isDeferredBlock() const
+{
+    const int blockNumber = currentBlock().blockNumber();
+    return blockNumber >= idleBlock && (blockNumber < visibleFirst || blockNumber > visibleLast);
+}
+
+/*
+ * True for a type 1-5 line of single space separated tokens that the line
+ * type formats cover completely. Only the line type rules show on such a line.
+ */
+bool Highlighter::isGeometryLine(const QString &text) const
+{
+    const int length = text.length();
+    if (length < 3 || text.at(0) < QLatin1Char('1') || text.at(0) > QLatin1Char('5') || text.at(1) != QLatin1Char(' '))
+        return false;
+
+    int tokens = 1;
+    const QChar *data = text.constData();
+    for (int i = 1; i < length; i++) {
+        const QChar c = data[i];
+        if (c == QLatin1Char(' ')) {
+            if (data[i - 1] == QLatin1Char(' ') || i == length - 1)
+                return false;
+            tokens++;
+        } else if (c.isSpace() || c == QLatin1Char('"') || c == QLatin1Char('<') || c == QLatin1Char('>') || c == QLatin1Char('=')) {
+            return false;
+        }
+    }
+
+    // type, colour and groups of three, optionally followed by the part
+    return tokens >= 15 || tokens % 3 == 2;
 }
 
 void Highlighter::highlightBlock(const QString &text)
 {
+    // blocks not yet reached by a deferred load only track the comment state
+    const bool deferredBlock = deferred && isDeferredBlock();
+    const bool geometryLine = !deferredBlock && isGeometryLine(text);
+    const QChar lineType = text.isEmpty() ? QChar() : text.at(0);
+
     // apply the predefined rules
-    const QVector<HighlightingRule> rules = highlightingRules;
-    for (const HighlightingRule &rule : rules) {
-        QRegularExpressionMatchIterator matchIterator = rule.pattern.globalMatch(text);
-        while (matchIterator.hasNext()) {
-            QRegularExpressionMatch match = matchIterator.next();
-            setFormat(match.capturedStart(), match.capturedLength(), rule.format);
+    if (!deferredBlock) {
+        for (const HighlightingRule &rule : highlightingRules) {
+            if (rule.anchor.isNull() ? geometryLine : rule.anchor != lineType)
+                continue;
+            QRegularExpressionMatchIterator matchIterator = rule.pattern.globalMatch(text);
+            while (matchIterator.hasNext()) {
+                QRegularExpressionMatch match = matchIterator.next();
+                setFormat(match.capturedStart(), match.capturedLength(), rule.format);
+            }
         }
     }
 
@@ -1072,7 +1202,7 @@ void Highlighter::highlightBlock(const QString &text)
 
     int startIndex = 0;
     if (previousBlockState() != 1)
-        startIndex = text.indexOf(LDrawMultiLineCommentStartExpression);
+        startIndex = text.contains(QLatin1String("/*")) ? text.indexOf(LDrawMultiLineCommentStartExpression) : -1;
 
     while (startIndex >= 0) {
         QRegularExpressionMatch match = LDrawMultiLineCommentEndExpression.match(text, startIndex);
@@ -1088,18 +1218,40 @@ void Highlighter::highlightBlock(const QString &text)
         startIndex = text.indexOf(LDrawMultiLineCommentStartExpression, startIndex + commentLength);
     }
 
+    if (deferredBlock)
+        return;
+
     // Geometry Line Types
     // 1 <colour> x y z a b c d e f g h i <file>
     // 2 <colour> x1 y1 z1 x2 y2 z2
     // 3 <colour> x1 y1 z1 x2 y2 z2 x3 y3 z3
     // 4 <colour> x1 y1 z1 x2 y2 z2 x3 y3 z3 x4 y4 z4
     // 5 <colour> x1 y1 z1 x2 y2 z2 x3 y3 z3 x4 y4 z4
-    QRegularExpression typeRx("^([1-5])\\s+");
-    QRegularExpression texmapRx("^0\\s+!?TEXMAP\\s+(?:START|NEXT)");
-    QRegularExpressionMatch typeMatch = typeRx.match(text);
+    if (geometryLine) {
+        // walk the single space separated tokens, the part takes the rest of the line
+        static const int lastTokens[] = { 0, 1, 4, 7, 10, 13 };
+        const bool type1 = lineType == QLatin1Char('1');
+        const int length = text.length();
+        int token = 0, group = 0, start = 0;
+        for (int i = 0; i <= length; i++) {
+            if (i < length && text.at(i) != QLatin1Char(' '))
+                continue;
+            if (group == 6 ? i == length : token == lastTokens[group]) {
+                if (type1 || group)                        // type format is set by the rules for type2_5
+                    setFormat(start, i - start, lineTypeFormats[group]);
+                start = i + 1;
+                group++;
+            }
+            token++;
+        }
+        return;
+    }
+
+    const bool typeLine = text.size() > 1 && lineType >= QLatin1Char('1') && lineType <= QLatin1Char('5') &&
+                          (text.at(1) == QLatin1Char(' ') || text.at(1) == QLatin1Char('\t'));
     int index = -1;
     bool texmap = false, type1_5 = false, type1 = false, type2_5 = false;
-    if ((type1_5 = typeMatch.hasMatch()) || (texmap = text.contains(texmapRx)))
+    if ((type1_5 = typeLine) || (texmap = lineType == QLatin1Char('0') && text.contains(LDrawTexmapExpression)))
         index = 0;
     else if (text.startsWith("0 GHOST "))
         index = 8;
@@ -1111,7 +1263,7 @@ void Highlighter::highlightBlock(const QString &text)
         return;
 
     if (type1_5) {
-        type1 = typeMatch.captured(1) == "1";
+        type1 = lineType == QLatin1Char('1');
         type2_5 = !type1;
     }
 
@@ -34,8 +34,12 @@
 #include <QTextCharFormat>
 #include <QSyntaxHighlighter>
 #include <QRegularExpression>
+#include <QElapsedTimer>
+#include <QPointer>
+#include <QTimer>
 
 class QTextDocument;
+class QPlainTextEdit;
 
 class Highlighter : public QSyntaxHighlighter
 {
@@ -45,17 +49,39 @@ class Highlighter : public QSyntaxHighlighter
 public:
     Highlighter(QTextDocument *parent = nullptr);
 
+    void setTextEdit(QPlainTextEdit *edit);
+    void deferHighlighting(int lineCount);
+
 protected:
     void highlightBlock(const QString &text);
 
+private slots:
+    void highlightVisibleBlocks();
+    void highlightIdleBlocks();
+
 private:
 
     struct HighlightingRule
     {
         QRegularExpression pattern;
         QTextCharFormat format;
+        QChar anchor;  // first character of lines the rule can match, null for any line
     };
 
+    bool isDeferredBlock() const;
+    bool isGeometryLine(const QString &text) const;
+
+    // deferred highlighting of large files
+    QPointer<QPlainTextEdit> textEdit;
+    QTimer idleTimer;
+    QElapsedTimer deferredTimer;
+    bool deferred;
+    int idleBlock;
+    int visibleFirst;
+    int visibleLast;
+
+    QRegularExpression LDrawTexmapExpression;
+
     QRegularExpression LDrawMultiLineCommentStartExpression;
     QRegularExpression LDrawMultiLineCommentEndExpression;
 
@@ -0,0 +1,227 @@
+/****************************************************************************
+**
+** Copyright (C) 2025 Trevor SANDY. All rights reserved.
+**
+** This file may be used under the terms of the
+** GNU General Public Liceense (GPL) version 3.0
+** which accompanies this distribution, and is
+** available at http://www.gnu.org/licenses/gpl.html
+**
+** This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+** WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+**
+****************************************************************************/
+
+#include "imagecache.h"
+
+#include <QCoreApplication>
+#include <QDir>
+#include <QFileInfo>
+#include <QDateTime>
+#include <QMutexLocker>
+#include <QThreadPool>
+#include <QtConcurrent>
+
+#include "lpub_preferences.h"
+#include "declarations.h"
+
+QCache<QString, ImageCache::Entry> ImageCache::images(IMAGE_CACHE_SIZE_DEFAULT * 1024);
+QHash<int, QStringList> ImageCache::pageImages;
+QSet<QString>           ImageCache::pending;
+QMutex                  ImageCache::mutex;
+QThreadPool            *ImageCache::prefetchPool = nullptr;
+int                     ImageCache::currentPage  = 0;
+int                     ImageCache::hits         = 0;
+int                     ImageCache::misses       = 0;
+int                     ImageCache::prefetched   = 0;
+
+QString ImageCache::key(const QString &fileName)
+{
+  const QFileInfo fileInfo(fileName);
+  if (!fileInfo.exists())
+    return QString();
+
+  return QString("%1|%2|%3").arg(fileInfo.absoluteFilePath())
+                            .arg(fileInfo.size())
+                            .arg(fileInfo.lastModified().toMSecsSinceEpoch());
+}
+
+// cost is counted in KB
+int ImageCache::cost(const QImage &image)
+{
+  return qMax(1, int(qint64(image.bytesPerLine()) * image.height() / 1024));
+}
+
+// the memory cap follows the ImageCacheSize preference - 0 disables the cache
+void ImageCache::updateMaxCost()
+{
+  const int maxCost = qMax(0, Preferences::imageCacheSize) * 1024;
+  if (images.maxCost() != maxCost)
+    images.setMaxCost(maxCost);
+}
+
+/*
+ * Load fileName into pixmap using the cached image when there is one.
+ * The file is recorded against the current page for adjacent page prefetch.
+ */
+bool ImageCache::loadPixmap(const QString &fileName, QPixmap *pixmap)
+{
+  if (!pixmap)
+    return false;
+
+  if (!Preferences::modeGUI)
+    return pixmap->load(fileName);
+
+  const QString imageKey = key(fileName);
+
+  {
+    QMutexLocker locker(&mutex);
+
+    updateMaxCost();
+
+    if (currentPage > 0 && !imageKey.isEmpty()) {
+      QStringList &files = pageImages[currentPage];
+      if (!files.contains(fileName))
+        files.append(fileName);
+    }
+
+    if (!imageKey.isEmpty()) {
+      if (Entry *cached = images.object(imageKey)) {
+        hits++;
+        // prefetched images are converted once, on the GUI thread
+        if (cached->pixmap.isNull()) {
+          cached->pixmap = QPixmap::fromImage(cached->image);
+          cached->image = QImage();
+        }
+        *pixmap = cached->pixmap;
+        return !pixmap->isNull();
+      }
+      misses++;
+    }
+  }
+
+  QImage image;
+  if (!image.load(fileName))
+    return pixmap->load(fileName);
+
+  *pixmap = QPixmap::fromImage(image);
+
+  if (!imageKey.isEmpty() && images.maxCost() && !pixmap->isNull()) {
+    QMutexLocker locker(&mutex);
+    Entry *entry = new Entry;
+    entry->pixmap = *pixmap;
+    images.insert(imageKey, entry, cost(image));
+  }
+
+  return !pixmap->isNull();
+}
+
+/*
+ * Make pageNum the page images are recorded against. Records of pages
+ * out of range of pageNum are dropped, so the records stay bounded.
+ */
+void ImageCache::setPage(int pageNum)
+{
+  QMutexLocker locker(&mutex);
+  currentPage = pageNum;
+  pageImages.remove(pageNum);
+
+  for (QHash<int, QStringList>::iterator i = pageImages.begin(); i != pageImages.end();) {
+    if (qAbs(i.key() - pageNum) > IMAGE_CACHE_PAGE_RANGE_DEFAULT)
+      i = pageImages.erase(i);
+    else
+      ++i;
+  }
+}
+
+/*
+ * Decode, in the background, the images recorded for the pages
+ * within range of pageNum that are not already cached.
+ */
+void ImageCache::prefetchPages(int pageNum, int range)
+{
+  QStringList fileNames;
+  {
+    QMutexLocker locker(&mutex);
+    for (int offset = 1; offset <= range; offset++) {
+      fileNames << pageImages.value(pageNum + offset);
+      fileNames << pageImages.value(pageNum - offset);
+    }
+  }
+
+  if (!fileNames.isEmpty())
+    prefetch(fileNames);
+}
+
+void ImageCache::prefetch(const QStringList &fileNames)
+{
+  QMutexLocker locker(&mutex);
+
+  if (!Preferences::modeGUI)
+    return;
+
+  updateMaxCost();
+
+  if (!images.maxCost())
+    return;
+
+  // the application owns the pool, so queued decodes finish before it exits
+  if (!prefetchPool) {
+    prefetchPool = new QThreadPool(qApp);
+    prefetchPool->setMaxThreadCount(1);
+    QObject::connect(prefetchPool, &QObject::destroyed, [] () { prefetchPool = nullptr; });
+  }
+
+  for (const QString &fileName : fileNames) {
+    const QString imageKey = key(fileName);
+    if (imageKey.isEmpty() || images.contains(imageKey) || pending.contains(imageKey))
+      continue;
+
+    pending.insert(imageKey);
+
+    QtConcurrent::run(prefetchPool, [imageKey, fileName] () {
+      QImage image;
+      const bool loaded = image.load(fileName);
+
+      QMutexLocker locker(&mutex);
+      pending.remove(imageKey);
+      if (loaded && !images.contains(imageKey)) {
+        Entry *entry = new Entry;
+        entry->image = image;
+        images.insert(imageKey, entry, cost(image));
+        prefetched++;
+      }
+    });
+  }
+}
+
+/*
+ * Drop the decoded images of the files in folder.
+ */
+void ImageCache::remove(const QString &folder)
+{
+  const QString prefix = QDir(folder).absolutePath() + QLatin1Char('/');
+
+  QMutexLocker locker(&mutex);
+
+  const QList<QString> imageKeys = images.keys();
+  for (const QString &imageKey : imageKeys)
+    if (imageKey.startsWith(prefix))
+      images.remove(imageKey);
+}
+
+void ImageCache::clear()
+{
+  QMutexLocker locker(&mutex);
+  images.clear();
+  pageImages.clear();
+}
+
+QString ImageCache::statistics()
+{
+  QMutexLocker locker(&mutex);
+
+  return QObject::tr("Image cache: %1 hits, %2 misses, %3 prefetched, %4 of %5 KB used")
+                     .arg(hits).arg(misses).arg(prefetched)
+                     .arg(images.totalCost()).arg(images.maxCost());
+}
@@ -0,0 +1,77 @@
+/****************************************************************************
+**
+** Copyright (C) 2025 Trevor SANDY. All rights reserved.
+**
+** This file may be used under the terms of the
+** GNU General Public Liceense (GPL) version 3.0
+** which accompanies this distribution, and is
+** available at http://www.gnu.org/licenses/gpl.html
+**
+** This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+** WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+**
+****************************************************************************/
+
+/****************************************************************************
+ *
+ * Process wide cache of decoded CSI, PLI and submodel images.
+ *
+ * Images are keyed on file path, size and modification time so a re-rendered
+ * file is never served from the cache. The cache is bounded by the
+ * ImageCacheSize preference (MB). A cached image is converted to a pixmap
+ * on its first use and the pixmap is served after that. The images loaded
+ * for the pages around the displayed page are recorded so the images of
+ * the adjacent pages can be decoded in the background before the user
+ * turns the page. Console runs load images directly without caching.
+ *
+ ***************************************************************************/
+
+#ifndef IMAGECACHE_H
+#define IMAGECACHE_H
+
+#include <QString>
+#include <QStringList>
+#include <QImage>
+#include <QPixmap>
+#include <QCache>
+#include <QMutex>
+#include <QHash>
+#include <QSet>
+
+class QThreadPool;
+
+class ImageCache
+{
+public:
+  ImageCache() {}
+  static bool loadPixmap(const QString &fileName, QPixmap *pixmap);
+  static void setPage(int pageNum);
+  static void prefetchPages(int pageNum, int range = 1);
+  static void prefetch(const QStringList &fileNames);
+  static void remove(const QString &folder);
+  static void clear();
+  static QString statistics();
+
+private:
+  struct Entry
+  {
+    QImage image;   // decoded image, released once converted
+    QPixmap pixmap; // converted on the GUI thread on first use
+  };
+
+  static QString key(const QString &fileName);
+  static int  cost(const QImage &image);
+  static void updateMaxCost();
+
+  static QCache<QString, Entry> images;
+  static QHash<int, QStringList> pageImages;
+  static QSet<QString> pending;
+  static QMutex mutex;
+  static QThreadPool *prefetchPool;
+  static int currentPage;
+  static int hits;
+  static int misses;
+  static int prefetched;
+};
+
+#endif // IMAGECACHE_H
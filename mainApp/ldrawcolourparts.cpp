@@ -15,15 +15,57 @@
 #include "ldrawcolourparts.h"
 #include <QFileInfo>
 #include <QTextStream>
+#include <QtConcurrent>
 #include "lpub_preferences.h"
 #include "QsLog.h"
 
 QHash<QString, QString>  LDrawColourParts::ldrawColourParts;
+QHash<QString, QString>  LDrawColourParts::prefetchParts;
+QString                  LDrawColourParts::prefetchFile;
+QString                  LDrawColourParts::prefetchResult;
+QFuture<bool>            LDrawColourParts::prefetchFuture;
+bool                     LDrawColourParts::prefetching = false;
+
+/*
+ * Read the color parts file on a worker thread during startup. The
+ * parts are kept aside until LDrawColorPartsLoad takes them, so the
+ * live list is only changed on the calling thread.
+ */
+void LDrawColourParts::LDrawColorPartsPrefetch()
+{
+    if (prefetching || ldrawColorPartsIsLoaded() || Preferences::ldrawColourPartsFile.isEmpty())
+        return;
+
+    prefetching = true;
+    prefetchFile = Preferences::ldrawColourPartsFile;
+    prefetchFuture = QtConcurrent::run([] () {
+        return readColorParts(prefetchFile, prefetchParts, prefetchResult);
+    });
+}
 
 bool LDrawColourParts::LDrawColorPartsLoad(QString &result)
 {
     ldrawColourParts.clear();
-    QString colorPartsFile = Preferences::ldrawColourPartsFile;
+
+    if (prefetching) {
+        prefetching = false;
+        const bool prefetched = prefetchFuture.result();
+        const bool current = prefetchFile == Preferences::ldrawColourPartsFile;
+        if (current) {
+            ldrawColourParts.swap(prefetchParts);
+            result = prefetchResult;
+        }
+        prefetchParts.clear();
+        prefetchResult.clear();
+        if (current)
+            return prefetched;
+    }
+
+    return readColorParts(Preferences::ldrawColourPartsFile, ldrawColourParts, result);
+}
+
+bool LDrawColourParts::readColorParts(const QString &colorPartsFile, QHash<QString, QString> &parts, QString &result)
+{
     QFile file(colorPartsFile);
     if ( ! file.open(QFile::ReadOnly | QFile::Text)) {
         result = file.errorString();
@@ -50,7 +92,7 @@ bool LDrawColourParts::LDrawColorPartsLoad(QString &result)
         if (sLine.contains(rx)) {
             QString partFile = rx.cap(1).toLower().trimmed();
             QString partLibType = rx.cap(2).toLower().trimmed();
-            ldrawColourParts.insert(partFile, QString("%1:::%2").arg(partLibType, partFile));
+            parts.insert(partFile, QString("%1:::%2").arg(partLibType, partFile));
             //qDebug() << "** Color part loaded: " << partFile << " Lib: " << QString("%1:::%2").arg(partLibType).arg(partFile);
         }
     }
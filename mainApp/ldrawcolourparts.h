@@ -17,16 +17,24 @@
 
 #include <QHash>
 #include <QString>
+#include <QFuture>
 
 class LDrawColourParts
 {
   private:
     static QHash<QString, QString>   ldrawColourParts;
+    static QHash<QString, QString>   prefetchParts;
+    static QString                   prefetchFile;
+    static QString                   prefetchResult;
+    static QFuture<bool>             prefetchFuture;
+    static bool                      prefetching;
+    static bool readColorParts(const QString &colorPartsFile, QHash<QString, QString> &parts, QString &result);
   public:
     LDrawColourParts(){}
     static bool ldrawColorPartsIsLoaded();
     static void clearGeneratedColorParts();
     static bool LDrawColorPartsLoad(QString &result);
+    static void LDrawColorPartsPrefetch();
     static bool isLDrawColourPart(QString part);
     static QString getLDrawColourPartInfo(QString part);
     static void addLDrawColorPart(QString part);
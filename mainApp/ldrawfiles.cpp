@@ -42,6 +42,7 @@
 #include <QRegExp>
 #include <QHash>
 #include <functional>
+#include <algorithm>
 #if (QT_VERSION >= QT_VERSION_CHECK(5, 0, 0))
 #include <QtConcurrent>
 #endif
@@ -49,6 +50,7 @@
 
 #include "lpub.h"
 #include "ldrawfilesload.h"
+#include "partpathindex.h"
 #include "QsLog.h"
 
 #include "lc_library.h"
@@ -220,6 +222,8 @@ LDrawSubFile::LDrawSubFile(
   _startPageNumber = 0;
   _lineTypeIndexes.clear();
   _subFileIndexes.clear();
+  _stepBoundaries.clear();
+  _stepBoundariesValid = false;
   _smiContents.clear();
   _prevStepPosition = { 0,0,0 };
 }
@@ -785,6 +789,7 @@ void LDrawFile::setContents(const QString &mcFileName, const QStringList &conten
     i.value()._modified = true;
     //i.value()._datetime = QDateTime::currentDateTime();
     i.value()._contents = contents;
+    i.value()._stepBoundariesValid = false;
     i.value()._changedSinceLastWrite = true;
   }
 }
@@ -1165,6 +1170,61 @@ void LDrawFile::resetLineTypeRelativeIndex(const QString &mcFileName) {
     }
 }
 
+/*
+ * True for the lines that end a step: ^0\s+STEP$|^0\s+ROTSTEP|^0\s+!DATA
+ */
+static bool isStepBoundaryLine(const QString &line)
+{
+  const int size = line.size();
+  if (size < 3 || line.at(0) != QLatin1Char('0') || !line.at(1).isSpace())
+    return false;
+
+  int start = 2;
+  while (start < size && line.at(start).isSpace())
+    start++;
+
+  auto keywordAt = [&line, size, start] (const char *keyword)
+  {
+    const int length = int(qstrlen(keyword));
+    if (size - start < length)
+      return false;
+    for (int c = 0; c < length; c++)
+      if (line.at(start + c).unicode() != ushort(keyword[c]))
+        return false;
+    return true;
+  };
+
+  return (keywordAt("STEP") && size - start == 4) || keywordAt("ROTSTEP") || keywordAt("!DATA");
+}
+
+/*
+ * Return the first line from lineNumber that ends the step, or the
+ * file size when the step runs to the end of the file. The boundary
+ * index is built on first use and kept by the line edit functions.
+ */
+int LDrawFile::stepBoundary(const QString &mcFileName, int lineNumber)
+{
+  QString fileName = mcFileName.toLower();
+  QMap<QString, LDrawSubFile>::iterator i = _subFiles.find(fileName);
+
+  if (i == _subFiles.end())
+    return 0;
+
+  LDrawSubFile &subFile = i.value();
+  if (!subFile._stepBoundariesValid) {
+    subFile._stepBoundaries.clear();
+    for (int n = 0; n < subFile._contents.size(); n++)
+      if (isStepBoundaryLine(subFile._contents.at(n)))
+        subFile._stepBoundaries.append(n);
+    subFile._stepBoundariesValid = true;
+  }
+
+  const QVector<int> &boundaries = subFile._stepBoundaries;
+  QVector<int>::const_iterator b = std::lower_bound(boundaries.constBegin(), boundaries.constEnd(), lineNumber);
+
+  return b != boundaries.constEnd() ? *b : subFile._contents.size();
+}
+
 QString LDrawFile::readLine(const QString &mcFileName, int lineNumber)
 {
   QString fileName = mcFileName.toLower();
@@ -1184,6 +1244,14 @@ void LDrawFile::insertLine(const QString &mcFileName, int lineNumber, const QStr
 
   if (i != _subFiles.end()) {
     i.value()._contents.insert(lineNumber,line);
+    if (i.value()._stepBoundariesValid) {
+      QVector<int> &boundaries = i.value()._stepBoundaries;
+      QVector<int>::iterator b = std::lower_bound(boundaries.begin(), boundaries.end(), lineNumber);
+      for (QVector<int>::iterator n = b; n != boundaries.end(); ++n)
+        ++*n;
+      if (isStepBoundaryLine(line))
+        boundaries.insert(b, lineNumber);
+    }
     i.value()._modified = true;
  //   i.value()._datetime = QDateTime::currentDateTime();
     i.value()._changedSinceLastWrite = true;
@@ -1197,6 +1265,17 @@ void LDrawFile::replaceLine(const QString &mcFileName, int lineNumber, const QSt
 
   if (i != _subFiles.end()) {
     i.value()._contents[lineNumber] = line;
+    if (i.value()._stepBoundariesValid) {
+      QVector<int> &boundaries = i.value()._stepBoundaries;
+      QVector<int>::iterator b = std::lower_bound(boundaries.begin(), boundaries.end(), lineNumber);
+      const bool indexed = b != boundaries.end() && *b == lineNumber;
+      if (isStepBoundaryLine(line) != indexed) {
+        if (indexed)
+          boundaries.erase(b);
+        else
+          boundaries.insert(b, lineNumber);
+      }
+    }
     i.value()._modified = true;
 //    i.value()._datetime = QDateTime::currentDateTime();
     i.value()._changedSinceLastWrite = true;
@@ -1210,12 +1289,26 @@ void LDrawFile::deleteLine(const QString &mcFileName, int lineNumber)
 
   if (i != _subFiles.end()) {
     i.value()._contents.removeAt(lineNumber);
+    if (i.value()._stepBoundariesValid) {
+      QVector<int> &boundaries = i.value()._stepBoundaries;
+      QVector<int>::iterator b = std::lower_bound(boundaries.begin(), boundaries.end(), lineNumber);
+      if (b != boundaries.end() && *b == lineNumber)
+        b = boundaries.erase(b);
+      for (QVector<int>::iterator n = b; n != boundaries.end(); ++n)
+        --*n;
+    }
     i.value()._modified = true;
 //    i.value()._datetime = QDateTime::currentDateTime();
     i.value()._changedSinceLastWrite = true;
   }
 }
 
+/*
+ * Apply an editor change at character position of the newline joined
+ * contents. Only the lines spanned by the change are rebuilt and spliced
+ * back, so the cost follows the size of the edit, not the size of the file.
+ */
+
 void LDrawFile::changeContents(
                     const QString &mcFileName,
                           int      position,
@@ -1223,12 +1316,87 @@ void LDrawFile::changeContents(
                     const QString &charsAdded)
 {
   QString fileName = mcFileName.toLower();
-  if (charsRemoved || charsAdded.size()) {
-    QString all = contents(fileName).join("\n");
-    all.remove(position,charsRemoved);
-    all.insert(position,charsAdded);
-    setContents(fileName,all.split("\n"));
+  if (!charsRemoved && charsAdded.isEmpty())
+    return;
+
+  QMap<QString, LDrawSubFile>::iterator i = _subFiles.find(fileName);
+  if (i == _subFiles.end())
+    return;
+
+  QStringList &lines = i.value()._contents;
+
+  if (lines.isEmpty()) {
+    setContents(fileName,charsAdded.split("\n"));
+    return;
+  }
+
+  // first and last line touched by the change and the position where each starts
+  int firstLine = 0, firstStart = 0;
+  while (firstLine < lines.size() - 1 && firstStart + lines.at(firstLine).size() < position) {
+    firstStart += lines.at(firstLine).size() + 1;
+    firstLine++;
+  }
+
+  int lastLine = firstLine, lastStart = firstStart;
+  while (lastLine < lines.size() - 1 && lastStart + lines.at(lastLine).size() < position + charsRemoved) {
+    lastStart += lines.at(lastLine).size() + 1;
+    lastLine++;
+  }
+
+  QString text = lines.mid(firstLine, lastLine - firstLine + 1).join("\n");
+  text.remove(position - firstStart,charsRemoved);
+  text.insert(position - firstStart,charsAdded);
+  const QStringList changedLines = text.split("\n");
+
+  const int replacedCount = lastLine - firstLine + 1;
+  const int commonCount   = qMin(replacedCount, changedLines.size());
+
+  for (int n = 0; n < commonCount; n++)
+    if (lines.at(firstLine + n) != changedLines.at(n))
+      lines[firstLine + n] = changedLines.at(n);
+
+  if (changedLines.size() > replacedCount) {
+    for (int n = commonCount; n < changedLines.size(); n++)
+      lines.insert(firstLine + n, changedLines.at(n));
+  } else {
+    lines.erase(lines.begin() + firstLine + commonCount, lines.begin() + firstLine + replacedCount);
   }
+
+  i.value()._stepBoundariesValid = false;
+  i.value()._modified = true;
+  i.value()._changedSinceLastWrite = true;
+}
+
+/*
+ * Return charCount characters from character position of the newline
+ * joined contents without building the joined string.
+ */
+
+QString LDrawFile::contentsRange(
+                    const QString &mcFileName,
+                          int      position,
+                          int      charCount)
+{
+  QString range;
+  QMap<QString, LDrawSubFile>::const_iterator i = _subFiles.constFind(mcFileName.toLower());
+  if (i == _subFiles.constEnd() || position < 0 || charCount <= 0)
+    return range;
+
+  const QStringList &lines = i.value()._contents;
+
+  int lineStart = 0;
+  for (int lineNumber = 0; lineNumber < lines.size() && range.size() < charCount; lineNumber++) {
+    const QString &line = lines.at(lineNumber);
+    const int lineEnd = lineStart + line.size();
+    if (lineEnd >= position) {
+      range.append(line.mid(qMax(position - lineStart, 0), charCount - range.size()));
+      if (range.size() < charCount && lineNumber < lines.size() - 1)
+        range.append('\n');
+    }
+    lineStart = lineEnd + 1;
+  }
+
+  return range;
 }
 
 /*  Only used by SubMeta::parse(...) to read fade or highlight content */
@@ -1867,6 +2035,9 @@ void LDrawFile::loadMPDFile(const QString &fileName, bool externalFile)
     if (Preferences::searchUnofficialTextures)
         if (!searchPaths.contains(ldrawPath + QDir::separator() + "UNOFFICIAL" + QDir::separator() + "TEXTURES",Qt::CaseInsensitive))
             searchPaths.append(ldrawPath + QDir::separator() + "UNOFFICIAL" + QDir::separator() + "TEXTURES");
+    // index the search paths once instead of probing each path for every subfile
+    if (Preferences::extendedSubfileSearch)
+        PartPathIndex::update(searchPaths);
 
     /* Read it in the first time to put into fileList in order of appearance */
 
@@ -2308,10 +2479,16 @@ void LDrawFile::loadMPDFile(const QString &fileName, bool externalFile)
                 }
                 if (!subfileFound) {
                     // extended search - LDraw subfolder paths and extra search directories
-                    for (QString const &subFilePath : searchPaths) {
-                        if ((subfileFound = QFileInfo(subFilePath + QDir::separator() + subfile).isFile())) {
-                            fileInfo = QFileInfo(subFilePath + QDir::separator() + subfile);
-                            break;
+                    QString const indexedPath = PartPathIndex::find(subfile, searchPaths);
+                    if ((subfileFound = !indexedPath.isEmpty())) {
+                        fileInfo = QFileInfo(indexedPath);
+                    } else if (subfile.contains('/') || subfile.contains('\\')) {
+                        // names with a directory part are not indexed
+                        for (QString const &subFilePath : searchPaths) {
+                            if ((subfileFound = QFileInfo(subFilePath + QDir::separator() + subfile).isFile())) {
+                                fileInfo = QFileInfo(subFilePath + QDir::separator() + subfile);
+                                break;
+                            }
                         }
                     }
                 }
@@ -2480,6 +2657,9 @@ void LDrawFile::loadLDRFile(const QString &filePath, const QString &fileName, bo
         if (Preferences::searchUnofficialTextures)
             if (!searchPaths.contains(ldrawPath + QDir::separator() + "UNOFFICIAL" + QDir::separator() + "TEXTURES",Qt::CaseInsensitive))
                 searchPaths.append(ldrawPath + QDir::separator() + "UNOFFICIAL" + QDir::separator() + "TEXTURES");
+        // index the search paths once instead of probing each path for every subfile
+        if (Preferences::extendedSubfileSearch)
+            PartPathIndex::update(searchPaths);
 
         /* Read it in the first time to put into fileList in order of appearance */
 
@@ -2876,10 +3056,16 @@ void LDrawFile::loadLDRFile(const QString &filePath, const QString &fileName, bo
                     }
                     if (!subfileFound) {
                         // extended search - LDraw subfolder paths and extra search directories
-                        for (QString const &subFilePath : searchPaths) {
-                            if ((subfileFound = QFileInfo(subFilePath + QDir::separator() + subfile).isFile())) {
-                                fileInfo = QFileInfo(subFilePath + QDir::separator() + subfile);
-                                break;
+                        QString const indexedPath = PartPathIndex::find(subfile, searchPaths);
+                        if ((subfileFound = !indexedPath.isEmpty())) {
+                            fileInfo = QFileInfo(indexedPath);
+                        } else if (subfile.contains('/') || subfile.contains('\\')) {
+                            // names with a directory part are not indexed
+                            for (QString const &subFilePath : searchPaths) {
+                                if ((subfileFound = QFileInfo(subFilePath + QDir::separator() + subfile).isFile())) {
+                                    fileInfo = QFileInfo(subFilePath + QDir::separator() + subfile);
+                                    break;
+                                }
                             }
                         }
                     }
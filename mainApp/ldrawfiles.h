@@ -221,6 +221,8 @@ public:
     QVector<int> _lineTypeIndexes;
     QVector<int> _prevStepPosition;
     QVector<int> _subFileIndexes;
+    QVector<int> _stepBoundaries;        // sorted line numbers of lines that end a step
+    bool         _stepBoundariesValid;
     int          _numSteps;
     int          _buildMods;
     bool         _beenCounted;
@@ -239,6 +241,7 @@ public:
     LDrawSubFile()
     {
       _unofficialPart = 0;
+      _stepBoundariesValid = false;
       _prevStepPosition = { 0,0,0 };
     }
     LDrawSubFile(
@@ -257,6 +260,7 @@ public:
       _smiContents.clear();
       _lineTypeIndexes.clear();
       _subFileIndexes.clear();
+      _stepBoundaries.clear();
       _prevStepPosition.clear();
       _renderedKeys.clear();
       _mirrorRenderedKeys.clear();
@@ -463,6 +467,10 @@ class LDrawFile {
                               int      position, 
                               int      charsRemoved, 
                         const QString &charsAdded);
+    QString contentsRange(const QString &fileName,
+                                int      position,
+                                int      charCount);
+    int stepBoundary(const QString &fileName, int lineNumber);
     // Only used to insert fade or highlight content
     void insertConfiguredSubFile (const QString &mcFileName,
                                         QStringList &contents,
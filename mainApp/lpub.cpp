@@ -52,6 +52,8 @@
 #include "step.h"
 #include "texteditdialog.h"
 #include "stickerparts.h"
+#include "pliimagestore.h"
+#include "imagecache.h"
 #include "blenderpreferences.h"
 #include "messageboxresizable.h"
 #include "separatorcombobox.h"
@@ -405,9 +407,16 @@ void Gui::displayPage()
     gui->clearPage(); // this includes freeSteps() so harvest old step items before calling
     DrawPageFlags dpFlags;
     dpFlags.updateViewer = lpub->currentStep ? lpub->currentStep->updateViewer : true;
+    ImageCache::setPage(Gui::displayPageNum);
     Gui::drawPage(dpFlags);
     Gui::pageProcessRunning = PROC_NONE;
     gui->saveDisplayedPage();
+    if (Preferences::modeGUI && !Gui::exporting() && !Gui::abortProcess())
+      ImageCache::prefetchPages(Gui::displayPageNum);
+    if (Preferences::debugLogging) {
+      emit gui->messageSig(LOG_DEBUG, PliImageStore::statistics());
+      emit gui->messageSig(LOG_DEBUG, ImageCache::statistics());
+    }
     if (Gui::abortProcess()) {
       QApplication::restoreOverrideCursor();
       if (Preferences::modeGUI) {
@@ -2114,6 +2123,13 @@ void Gui::clearPLICache()
         }
     }
 
+    // the shared image store is only emptied on explicit request, other
+    // resets just drop the decoded pixmaps of the removed images
+    if (showMsg)
+        count += PliImageStore::clear();
+    else
+        PliImageStore::clearPixmaps();
+
     emit gui->messageSig(showMsg ? LOG_INFO : LOG_INFO_STATUS,
                     tr("Parts content cache cleaned. %1 %2 removed.")
                                        .arg(count).arg(count == 1 ? QLatin1String("item") : QLatin1String("items")),showMsg);
@@ -367,7 +367,12 @@ bool LPub::OpenProject(const NativeOptions* Options, int Type/*NATIVE_VIEW*/, bo
         }
     }
 
-    if (Type != NATIVE_VIEW) // NATIVE_IMAGE or NATIVE_EXPORT
+    if (Type == NATIVE_IMAGE && UseFile && !Options->InputFileName.isEmpty())
+    {
+        // reuse the resident render project when the content allows it
+        Loaded = nativeSession.LoadProject(Options);
+    }
+    else if (Type != NATIVE_VIEW) // NATIVE_IMAGE or NATIVE_EXPORT
     {
         if (Type == NATIVE_IMAGE)
             Loader = new Project(false/*IsPreview*/, NATIVE_IMAGE);
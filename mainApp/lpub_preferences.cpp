@@ -426,6 +426,7 @@ bool    Preferences::perspectiveProjection      = true;
 bool    Preferences::saveOnRedraw               = true;
 bool    Preferences::saveOnUpdate               = true;
 bool    Preferences::useNativePovGenerator      = true;
+bool    Preferences::nativeSoftwareRenderer     = false;
 bool    Preferences::blenderAddonVersionCheck   = true;
 
 bool    Preferences::applyCALocally             = true;
@@ -494,6 +495,7 @@ bool    Preferences::cycleEachPage              = false;
 
 bool    Preferences::usingNPP                   = false;
 bool    Preferences::pdfPageImage               = false;
+bool    Preferences::pdfPageImageLossless       = false;
 bool    Preferences::ignoreMixedPageSizesMsg    = false;
 
 bool    Preferences::logging                    = true;    // logging on/off offLevel     (grp box)
@@ -589,6 +591,7 @@ int     Preferences::pageHeight                 = PAGE_HEIGHT_DEFAULT;
 int     Preferences::pageWidth                  = PAGE_WIDTH_DEFAULT;
 int     Preferences::rendererTimeout            = RENDERER_TIMEOUT_DEFAULT;          // measured in seconds
 int     Preferences::pageDisplayPause           = PAGE_DISPLAY_PAUSE_DEFAULT;        // measured in seconds
+int     Preferences::imageCacheSize             = IMAGE_CACHE_SIZE_DEFAULT;          // measured in MB
 int     Preferences::nativeImageCameraFoVAdjust = NATIVE_IMAGE_CAMERA_FOV_ADJUST;
 int     Preferences::msgBoxMinimumWidth         = DEFAULT_MSG_BOX_MIN_WIDTH;
 
@@ -1175,6 +1178,9 @@ void Preferences::loggingPreferences()
         logger.addDestination(debugDestination);
         logger.addDestination(fileDestination);
 
+        // queue messages and write them in batches from the logger thread
+        logger.setAsynchronousWrite(true);
+
         // logging examples
         bool showLogExamples = false;
         if (showLogExamples)
@@ -2568,6 +2574,16 @@ void Preferences::preferredRendererPreferences(bool persist)
         applyCALocally = Settings.value(QString("%1/%2").arg(SETTINGS,"ApplyCALocally")).toBool();
     }
 
+    // Native renderer rasterize on the CPU instead of the OpenGL framebuffer
+    QString const nativeSoftwareRendererKey("NativeSoftwareRenderer");
+
+    if ( ! Settings.contains(QString("%1/%2").arg(SETTINGS,nativeSoftwareRendererKey)) || persist) {
+        QVariant eValue(nativeSoftwareRenderer);
+        Settings.setValue(QString("%1/%2").arg(SETTINGS,nativeSoftwareRendererKey),eValue);
+    } else {
+        nativeSoftwareRenderer = Settings.value(QString("%1/%2").arg(SETTINGS,nativeSoftwareRendererKey)).toBool();
+    }
+
     // set LDView ini
     if (Preferences::preferredRenderer == RENDERER_POVRAY) {
         if (Preferences::useNativePovGenerator)
@@ -5215,6 +5231,13 @@ void Preferences::exportPreferences()
     } else {
       pdfPageImage = Settings.value(QString("%1/%2").arg(DEFAULTS,"PdfPageImage")).toBool();
     }
+
+    if ( ! Settings.contains(QString("%1/%2").arg(DEFAULTS,"PdfPageImageLossless"))) {
+      QVariant uValue(pdfPageImageLossless);
+      Settings.setValue(QString("%1/%2").arg(DEFAULTS,"PdfPageImageLossless"),uValue);
+    } else {
+      pdfPageImageLossless = Settings.value(QString("%1/%2").arg(DEFAULTS,"PdfPageImageLossless")).toBool();
+    }
 }
 
 void Preferences::publishingPreferences()
@@ -5229,6 +5252,14 @@ void Preferences::publishingPreferences()
         pageDisplayPause = Settings.value(QString("%1/%2").arg(SETTINGS,"PageDisplayPause")).toInt();
     }
 
+    //Decoded Image Cache Size
+    if ( ! Settings.contains(QString("%1/%2").arg(SETTINGS,"ImageCacheSize"))) {
+        imageCacheSize = IMAGE_CACHE_SIZE_DEFAULT;
+        Settings.setValue(QString("%1/%2").arg(SETTINGS,"ImageCacheSize"),imageCacheSize);
+    } else {
+        imageCacheSize = Settings.value(QString("%1/%2").arg(SETTINGS,"ImageCacheSize")).toInt();
+    }
+
     if ( ! Settings.contains(QString("%1/%2").arg(DEFAULTS,"DoNotShowPageProcessDlg"))) {
         QVariant uValue(doNotShowPageProcessDlg);
         Settings.setValue(QString("%1/%2").arg(DEFAULTS,"DoNotShowPageProcessDlg"),uValue);
@@ -5590,6 +5621,16 @@ bool Preferences::getPreferences()
                                   .arg(pageDisplayPause));
         }
 
+        if (imageCacheSize != dialog->imageCacheSize()) {
+            const int imageCacheSizeCompare = imageCacheSize;
+            imageCacheSize = dialog->imageCacheSize();
+            Settings.setValue(QString("%1/%2").arg(SETTINGS,"ImageCacheSize"),imageCacheSize);
+
+            emit lpub->messageSig(LOG_INFO,QMessageBox::tr("Decoded image cache size changed from %1 MB to %2 MB")
+                                  .arg(imageCacheSizeCompare)
+                                  .arg(imageCacheSize));
+        }
+
         if (!dialog->documentLogoFile().isEmpty()) {
             if (QFileInfo(dialog->documentLogoFile()).isReadable()) {
                 QString const file = QDir::toNativeSeparators(dialog->documentLogoFile());
@@ -6298,6 +6339,15 @@ bool Preferences::getPreferences()
                                                                        QMessageBox::tr("Always Show")));
         }
 
+        if (nativeSoftwareRenderer != dialog->nativeSoftwareRenderer())
+        {
+            nativeSoftwareRenderer = dialog->nativeSoftwareRenderer();
+            Settings.setValue(QString("%1/%2").arg(SETTINGS,"NativeSoftwareRenderer"),nativeSoftwareRenderer);
+
+            emit lpub->messageSig(LOG_INFO,QMessageBox::tr("Native Software Renderer is %1")
+                                  .arg(nativeSoftwareRenderer ? On : Off));
+        }
+
         if (inlineNativeContent != dialog->inlineNativeContent())
         {
             inlineNativeContent = dialog->inlineNativeContent();
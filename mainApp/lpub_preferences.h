@@ -342,6 +342,7 @@ class Preferences
     static bool    blenderAddonVersionCheck;
 
     static bool    useNativePovGenerator;
+    static bool    nativeSoftwareRenderer;
     static bool    enableFadeSteps;
     static bool    fadeStepsUseColour;
 
@@ -359,6 +360,7 @@ class Preferences
     static bool    cycleEachPage;
 
     static bool    pdfPageImage;
+    static bool    pdfPageImageLossless;
     static bool    ignoreMixedPageSizesMsg;
 
     static bool    logging;         // global preference, logging on/off offLevel (grp box)
@@ -442,6 +444,7 @@ class Preferences
     static int     pageHeight;
     static int     gridSizeIndex;
     static int     pageDisplayPause;
+    static int     imageCacheSize;
     static int     rendererTimeout;
     static int     sceneGuidesLine;
     static int     sceneGuidesPosition;
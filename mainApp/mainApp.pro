@@ -550,6 +550,7 @@ HEADERS += \
     highlighter.h \
     highlightersimple.h \
     historylineedit.h \
+    imagecache.h \
     hoverpoints.h \
     ldrawcolordialog.h \
     ldrawcolourparts.h \
@@ -581,11 +582,13 @@ HEADERS += \
     pairdialog.h \
     parmshighlighter.h \
     parmswindow.h \
+    partpathindex.h \
     paths.h \
     placement.h \
     placementdialog.h \
     pli.h \
     pliannotationdialog.h \
+    pliimagestore.h \
     pliconstraindialog.h \
     plisortdialog.h \
     plisubstituteparts.h \
@@ -600,6 +603,7 @@ HEADERS += \
     ranges.h \
     ranges_element.h \
     ranges_item.h \
+    referencetable.h \
     render.h \
     renderdialog.h \
     reserve.h \
@@ -674,6 +678,7 @@ SOURCES += \
     highlightersimple.cpp \
     highlightstepglobals.cpp \
     historylineedit.cpp \
+    imagecache.cpp \
     hoverpoints.cpp \
     lclibpreferences.cpp \
     ldrawcolordialog.cpp \
@@ -707,11 +712,13 @@ SOURCES += \
     pairdialog.cpp \
     parmshighlighter.cpp \
     parmswindow.cpp \
+    partpathindex.cpp \
     paths.cpp \
     placement.cpp \
     placementdialog.cpp \
     pli.cpp \
     pliannotationdialog.cpp \
+    pliimagestore.cpp \
     pliconstraindialog.cpp \
     pliglobals.cpp \
     plisortdialog.cpp \
@@ -728,6 +735,7 @@ SOURCES += \
     ranges.cpp \
     ranges_element.cpp \
     ranges_item.cpp \
+    referencetable.cpp \
     render.cpp \
     renderdialog.cpp \
     reserve.cpp \
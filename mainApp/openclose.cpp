@@ -33,6 +33,7 @@
 #include "lc_profile.h"
 #include "lc_previewwidget.h"
 #include "waitingspinnerwidget.h"
+#include "imagecache.h"
 
 #include <LDVQt/LDVImageMatte.h>
 
@@ -959,6 +960,7 @@ void Gui::closeModelFile()
     Gui::curFile.clear();       // clear file from Gui::curFile here...
     // Gui
     Gui::clearPage(true);
+    ImageCache::clear();
     gui->disableActions();
     gui->disableEditActions();
     gui->closeFileOperations();
@@ -0,0 +1,196 @@
+/****************************************************************************
+**
+** Copyright (C) 2025 Trevor SANDY. All rights reserved.
+**
+** This file may be used under the terms of the
+** GNU General Public Liceense (GPL) version 3.0
+** which accompanies this distribution, and is
+** available at http://www.gnu.org/licenses/gpl.html
+**
+** This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+** WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+**
+****************************************************************************/
+
+#include "partpathindex.h"
+
+#include <QFile>
+#include <QFileInfo>
+#include <QDateTime>
+#include <QDirIterator>
+#include <QDataStream>
+#include <QSaveFile>
+#include <QElapsedTimer>
+#include <QMutexLocker>
+#include <QtConcurrent>
+
+#include "lpub_preferences.h"
+#include "QsLog.h"
+
+static const quint32 PartPathIndexMagic   = 0x4950504c; // 'LPPI'
+static const quint32 PartPathIndexVersion = 1;
+
+QHash<QString, PartPathIndex::Directory> PartPathIndex::directories;
+QMutex PartPathIndex::mutex;
+bool   PartPathIndex::loaded = false;
+
+static QString dirKey(const QString &dirPath)
+{
+  return QDir::cleanPath(QDir::fromNativeSeparators(dirPath));
+}
+
+QString PartPathIndex::indexPath()
+{
+  return QDir::toNativeSeparators(QString("%1/partpaths.idx").arg(Preferences::lpub3dCachePath));
+}
+
+qint64 PartPathIndex::modifiedTime(const QString &dirPath)
+{
+  const QFileInfo dirInfo(dirPath);
+  return dirInfo.isDir() ? dirInfo.lastModified().toMSecsSinceEpoch() : -1;
+}
+
+// the time is taken before the listing so a change made while listing is picked up next time
+PartPathIndex::Directory PartPathIndex::listDirectory(const QString &dirPath)
+{
+  Directory directory;
+  directory.modified = modifiedTime(dirPath);
+
+  QDirIterator it(dirPath, QDir::Files);
+  while (it.hasNext()) {
+    it.next();
+    const QString fileName = it.fileName();
+    directory.files.insert(fileName.toLower(), fileName);
+  }
+
+  return directory;
+}
+
+/*
+ * True when dirPath has at least one entry matching filters.
+ * Unlike QDir::entryInfoList, the listing stops at the first entry.
+ */
+bool PartPathIndex::hasEntries(const QString &dirPath, QDir::Filters filters)
+{
+  QDirIterator it(dirPath, filters);
+  return it.hasNext();
+}
+
+void PartPathIndex::load()
+{
+  loaded = true;
+
+  QFile file(indexPath());
+  if (!file.open(QIODevice::ReadOnly))
+    return;
+
+  QDataStream in(&file);
+  quint32 magic = 0, version = 0, count = 0;
+  in >> magic >> version >> count;
+  if (magic != PartPathIndexMagic || version != PartPathIndexVersion)
+    return;
+
+  for (quint32 i = 0; i < count && in.status() == QDataStream::Ok; i++) {
+    QString dirPath;
+    QStringList fileNames;
+    Directory directory;
+    in >> dirPath >> directory.modified >> fileNames;
+    directory.files.reserve(fileNames.size());
+    for (const QString &fileName : fileNames)
+      directory.files.insert(fileName.toLower(), fileName);
+    directories.insert(dirPath, directory);
+  }
+
+  if (in.status() != QDataStream::Ok)
+    directories.clear();
+}
+
+void PartPathIndex::save()
+{
+  if (!QDir().mkpath(Preferences::lpub3dCachePath))
+    return;
+
+  QSaveFile file(indexPath());
+  if (!file.open(QIODevice::WriteOnly))
+    return;
+
+  QDataStream out(&file);
+  out << PartPathIndexMagic << PartPathIndexVersion << quint32(directories.size());
+  for (QHash<QString, Directory>::const_iterator i = directories.constBegin(); i != directories.constEnd(); ++i)
+    out << i.key() << i.value().modified << QStringList(i.value().files.values());
+
+  if (!file.commit())
+    logWarning() << qPrintable(QString("Could not write part path index %1").arg(indexPath()));
+}
+
+/*
+ * Bring the index up to date for searchDirs. Directories whose
+ * modification time changed, or that are not indexed yet, are
+ * listed in parallel.
+ */
+void PartPathIndex::update(const QStringList &searchDirs)
+{
+  QElapsedTimer timer;
+  timer.start();
+
+  QStringList staleDirs;
+  {
+    QMutexLocker locker(&mutex);
+    if (!loaded)
+      load();
+
+    for (const QString &searchDir : searchDirs) {
+      const QString dirPath = dirKey(searchDir);
+      const qint64 modified = modifiedTime(dirPath);
+      if (modified < 0) {
+        directories.remove(dirPath);
+        continue;
+      }
+      QHash<QString, Directory>::const_iterator i = directories.constFind(dirPath);
+      if ((i == directories.constEnd() || i.value().modified != modified) && !staleDirs.contains(dirPath))
+        staleDirs.append(dirPath);
+    }
+  }
+
+  if (staleDirs.isEmpty())
+    return;
+
+  const QList<Directory> listedDirs = QtConcurrent::blockingMapped<QList<Directory> >(staleDirs, &PartPathIndex::listDirectory);
+
+  QMutexLocker locker(&mutex);
+  for (int i = 0; i < staleDirs.size() && i < listedDirs.size(); i++)
+    directories.insert(staleDirs.at(i), listedDirs.at(i));
+
+  save();
+
+  logInfo() << qPrintable(QString("Part path index: listed %1 of %2 search directories in %3 ms")
+                                  .arg(staleDirs.size()).arg(searchDirs.size()).arg(timer.elapsed()));
+}
+
+/*
+ * Return the path of fileName in the first of searchDirs that holds it,
+ * compared without case. Names with a directory part are not indexed
+ * and return an empty string, as do names not found.
+ */
+QString PartPathIndex::find(const QString &fileName, const QStringList &searchDirs)
+{
+  if (fileName.isEmpty() || fileName.contains(QLatin1Char('/')) || fileName.contains(QLatin1Char('\\')))
+    return QString();
+
+  const QString name = fileName.toLower();
+
+  QMutexLocker locker(&mutex);
+  if (!loaded)
+    load();
+
+  for (const QString &searchDir : searchDirs) {
+    QHash<QString, Directory>::const_iterator i = directories.constFind(dirKey(searchDir));
+    if (i == directories.constEnd())
+      continue;
+    QHash<QString, QString>::const_iterator f = i.value().files.constFind(name);
+    if (f != i.value().files.constEnd())
+      return QDir::toNativeSeparators(QString("%1/%2").arg(i.key()).arg(f.value()));
+  }
+
+  return QString();
+}
@@ -0,0 +1,62 @@
+/****************************************************************************
+**
+** Copyright (C) 2025 Trevor SANDY. All rights reserved.
+**
+** This file may be used under the terms of the
+** GNU General Public Liceense (GPL) version 3.0
+** which accompanies this distribution, and is
+** available at http://www.gnu.org/licenses/gpl.html
+**
+** This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+** WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+**
+****************************************************************************/
+
+/****************************************************************************
+ *
+ * Persistent index of the files in the LDraw search directories.
+ *
+ * Each directory is listed once, in parallel with the other directories,
+ * and stored with its modification time in the user cache folder. Later
+ * sessions only compare directory times and list the directories that
+ * changed. A file name is resolved with a lower case hash lookup per
+ * directory instead of probing the file system.
+ *
+ ***************************************************************************/
+
+#ifndef PARTPATHINDEX_H
+#define PARTPATHINDEX_H
+
+#include <QString>
+#include <QStringList>
+#include <QHash>
+#include <QMutex>
+#include <QDir>
+
+class PartPathIndex
+{
+public:
+  PartPathIndex() {}
+  static void update(const QStringList &searchDirs);
+  static QString find(const QString &fileName, const QStringList &searchDirs);
+  static bool hasEntries(const QString &dirPath, QDir::Filters filters);
+
+private:
+  struct Directory
+  {
+    qint64 modified = -1;
+    QHash<QString, QString> files; // lower case name, file name
+  };
+
+  static QString indexPath();
+  static qint64 modifiedTime(const QString &dirPath);
+  static Directory listDirectory(const QString &dirPath);
+  static void load();
+  static void save();
+
+  static QHash<QString, Directory> directories;
+  static QMutex mutex;
+  static bool loaded;
+};
+
+#endif // PARTPATHINDEX_H
@@ -52,6 +52,8 @@
 #include "ranges_element.h"
 #include "range_element.h"
 #include "dependencies.h"
+#include "pliimagestore.h"
+#include "imagecache.h"
 
 #include "pieceinf.h"
 #include "lc_viewwidget.h"
@@ -771,16 +773,10 @@ void Pli::getAnnotation(
           return;
         }
       if (titleAnnotations.size() > 0) {
-          QString annotation,sClean;
-          for (int i = 0; i < titleAnnotations.size(); i++) {
-              annotation = titleAnnotations[i];
-              QRegExp rx(annotation);
-              if (annotateStr.contains(rx)) {
-                  sClean = rx.cap(1);
-                  sClean.remove(QRegExp("\\s"));            //remove spaces
-                  annotateStr = sClean;
-                  return;
-                }
+          QString annotation;
+          if (Annotations::titleAnnotation(type, annotateStr, annotation)) {
+              annotateStr = annotation;
+              return;
             }
         }
       if (titleAndFreeform) {
@@ -1036,6 +1032,29 @@ int Pli::createPartImage(
 
     PliType pliType = isSubModel ? SUBMODEL: bom ? BOM : PART;
 
+    // image store attributes that impact the rendered image but are not part of the name key
+    QStringList storeAttributes;
+    bool useImageStore = !isSubModel && !keySub && !lpub->ldrawFile.contains(type);
+    if (useImageStore) {
+        StudStyleMeta* ssm = meta->LPub.studStyle.value() ? &meta->LPub.studStyle : &pliMeta.studStyle;
+        AutoEdgeColorMeta* aecm = meta->LPub.autoEdgeColor.enable.value() ? &meta->LPub.autoEdgeColor : &pliMeta.autoEdgeColor;
+        HighContrastColorMeta* hccm = meta->LPub.studStyle.value() ? &meta->LPub.highContrast : &pliMeta.highContrast;
+        storeAttributes
+            << rendererNames[Render::getRenderer()]
+            << QString::number(Preferences::perspectiveProjection)
+            << QString::number(pliMeta.isOrtho.value())
+            << pliMeta.cameraName.value()
+            << QString("%1_%2_%3").arg(double(pliMeta.cameraDistance.value())).arg(double(pliMeta.cameraZNear.value())).arg(double(pliMeta.cameraZFar.value()))
+            << QString("%1_%2_%3").arg(double(pliMeta.position.x())).arg(double(pliMeta.position.y())).arg(double(pliMeta.position.z()))
+            << QString("%1_%2_%3").arg(double(pliMeta.upvector.x())).arg(double(pliMeta.upvector.y())).arg(double(pliMeta.upvector.z()))
+            << pliMeta.ldviewParms.value() << pliMeta.ldgliteParms.value() << pliMeta.povrayParms.value()
+            << QString("%1_%2_%3_%4").arg(ssm->value()).arg(aecm->enable.value()).arg(double(aecm->contrast.value())).arg(double(aecm->saturation.value()))
+            << QString("%1_%2_%3_%4").arg(double(hccm->lightDarkIndex.value())).arg(hccm->studCylinderColor.value()).arg(hccm->partEdgeColor.value()).arg(hccm->blackEdgeColor.value())
+            << QString("%1_%2_%3").arg(hccm->darkEdgeColor.value()).arg(Preferences::validFadeStepsColour).arg(Preferences::fadeStepsOpacity)
+            << Preferences::highlightStepColour
+            << QDir::toNativeSeparators(Preferences::ldrawLibPath);
+    }
+
     for (int pT = 0; pT < ptn.size(); pT++ ) {
         int ptRc = 0;
 //#ifdef QT_DEBUG_MODE
@@ -1082,6 +1101,10 @@ int Pli::createPartImage(
         if (keySub || bom)
             renderImageName = QDir::toNativeSeparators(QString("%1/%2/%3%4.png").arg(QDir::currentPath()).arg(imageDir).arg(altNameKey).arg(ptn[pT].typeName));
 
+        // content key shared by all projects rendering this part with the same settings
+        const bool useStoreKey = useImageStore && renderImageName == imageName;
+        QString storeKey;
+
         QFile part(imageName);
 
         // Populate viewerPliPartiKey variable
@@ -1218,6 +1241,17 @@ int Pli::createPartImage(
             QString pliPartKey = QString("%1;%3").arg(keyPart1).arg(keyPart2);
             lpub->ldrawFile.insertViewerStep(viewerPliPartKey,pliFile,pliFileR,pliFileU,ldrNames.first(),imageName,pliPartKey,multistep,callout,Options::PLI);
 
+            // reuse the image rendered with the same settings by another project - the
+            // key stamps the part file, so it is only built when the image is missing
+            if (! rc && ! part.exists() && useStoreKey) {
+                storeKey = PliImageStore::key(QStringList() << nameKey << ptn[pT].typeName << ia.partColor[pT] << storeAttributes
+                                                            << PliImageStore::contentStamp(type, ia.partColor[pT]));
+                if (PliImageStore::restore(storeKey,imageName))
+                    emit gui->messageSig(LOG_INFO,QObject::tr("PLI [%1] image restored from image store [%2].")
+                                         .arg(PartTypeNames[pT])
+                                         .arg(imageName));
+            }
+
             if (! rc && ! part.exists()) {
 
                 // create a temporary DAT to feed the renderer
@@ -1242,7 +1276,10 @@ int Pli::createPartImage(
                                          .arg(PartTypeNames[pT])
                                          .arg(imageName));
                     imageName = QString(":/resources/missingimage.png");
+                    storeKey.clear();
                     ptRc = -1;
+                } else {
+                    PliImageStore::insert(storeKey,imageName);
                 }
             }
         }
@@ -1267,7 +1304,7 @@ int Pli::createPartImage(
             emit gui->setPliIconPathSig(imageKey,imageName);
 
         if (pixmap && (pT == NORMAL_PART))
-            pixmap->load(imageName);
+            PliImageStore::loadPixmap(imageName,pixmap);
 
         if (showElapsedTime) {
             if (!ptRc) {
@@ -1316,7 +1353,7 @@ int Pli::createPartImagesLDViewSCall(QStringList &ldrNames, bool isNormalPart, i
                 continue;
             }
 
-            if (! pixmap->load(part->imageName)) {
+            if (! ImageCache::loadPixmap(part->imageName, pixmap)) {
                 emit gui->messageSig(LOG_ERROR,QObject::tr("Could not load PLI pixmap image.<br>%1 was not found.")
                                      .arg(part->imageName));
                 part->imageName = QString(":/resources/missingimage.png");
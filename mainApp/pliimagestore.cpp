@@ -0,0 +1,256 @@
+/****************************************************************************
+**
+** Copyright (C) 2025 Trevor SANDY. All rights reserved.
+**
+** This file may be used under the terms of the
+** GNU General Public Liceense (GPL) version 3.0
+** which accompanies this distribution, and is
+** available at http://www.gnu.org/licenses/gpl.html
+**
+** This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+** WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+**
+****************************************************************************/
+
+#include "pliimagestore.h"
+
+#include <QCoreApplication>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QDateTime>
+#include <QCryptographicHash>
+#include <QMutexLocker>
+
+#include "lpub_preferences.h"
+#include "imagecache.h"
+#include "partpathindex.h"
+#include "color.h"
+#include "paths.h"
+#include "render.h"
+#include "lpub.h"
+
+#include "lc_application.h"
+
+QMutex PliImageStore::mutex;
+int PliImageStore::storeHits    = 0;
+int PliImageStore::storeMisses  = 0;
+
+QString PliImageStore::key(const QStringList &attributes)
+{
+  return QString::fromLatin1(QCryptographicHash::hash(attributes.join(QLatin1Char('|')).toUtf8(),
+                                                      QCryptographicHash::Sha1).toHex());
+}
+
+QString PliImageStore::fileStamp(const QString &fileName)
+{
+  const QFileInfo fileInfo(fileName);
+  if (!fileInfo.exists())
+    return QLatin1String("-");
+  return QString("%1_%2").arg(fileInfo.size()).arg(fileInfo.lastModified().toMSecsSinceEpoch());
+}
+
+/*
+ * Return the loose file type resolves to, in the order the parts are
+ * searched: the model folder, the search directories, then the library
+ * folders. Parts only held in the library archives return an empty string.
+ */
+QString PliImageStore::partFile(const QString &type)
+{
+  const QString name = QDir::fromNativeSeparators(type);
+
+  if (!Gui::curFile.isEmpty()) {
+    const QString modelFile = QString("%1/%2").arg(QFileInfo(Gui::curFile).absolutePath()).arg(name);
+    if (QFileInfo(modelFile).isFile())
+      return modelFile;
+  }
+
+  const QString searchFile = PartPathIndex::find(name, Preferences::ldSearchDirs);
+  if (!searchFile.isEmpty())
+    return searchFile;
+
+  const QStringList libraryDirs = QStringList()
+    << QLatin1String("parts") << QLatin1String("p")
+    << QLatin1String("unofficial/parts") << QLatin1String("unofficial/p");
+  for (const QString &libraryDir : libraryDirs) {
+    const QString libraryFile = QString("%1/%2/%3").arg(Preferences::ldrawLibPath).arg(libraryDir).arg(name);
+    if (QFileInfo(libraryFile).isFile())
+      return libraryFile;
+  }
+
+  return QString();
+}
+
+/*
+ * Stamp of the renderer settings that are not in the PLI meta: the
+ * renderer ini files and the Visual Editor preferences used by the
+ * native renderer.
+ */
+QString PliImageStore::rendererStamp()
+{
+  switch (Render::getRenderer()) {
+  case RENDERER_NATIVE: {
+    const lcPreferences &lcPrefs = lcGetPreferences();
+    return QString("%1_%2_%3_%4_%5_%6_%7_%8_%9")
+                   .arg(int(lcPrefs.mShadingMode))
+                   .arg(lcPrefs.mDrawEdgeLines)
+                   .arg(lcPrefs.mDrawConditionalLines)
+                   .arg(double(lcPrefs.mLineWidth))
+                   .arg(lcPrefs.mAllowLOD)
+                   .arg(double(lcPrefs.mMeshLODDistance))
+                   .arg(double(lcPrefs.mDDF))
+                   .arg(lcPrefs.mNativeViewpoint)
+                   .arg(lcPrefs.mNativeProjection)
+         + QString("_%1_%2_%3_%4")
+                   .arg(double(lcPrefs.mCFoV))
+                   .arg(double(lcPrefs.mCNear))
+                   .arg(double(lcPrefs.mCFar))
+                   .arg(Preferences::nativeSoftwareRenderer);
+  }
+  case RENDERER_LDVIEW:
+    return fileStamp(Preferences::ldviewIni);
+  case RENDERER_LDGLITE:
+    return fileStamp(Preferences::ldgliteIni);
+  case RENDERER_POVRAY:
+    return QString("%1_%2").arg(fileStamp(Preferences::useNativePovGenerator ? Preferences::nativeExportIni : Preferences::ldviewPOVIni))
+                           .arg(fileStamp(Preferences::povrayIni));
+  default:
+    return QString();
+  }
+}
+
+/*
+ * Stamp of the content behind a rendered part image: the part file,
+ * the library archives, the colour definition and the renderer settings.
+ */
+QString PliImageStore::contentStamp(const QString &type, const QString &colorCode)
+{
+  const QString libraryDir = QFileInfo(Preferences::lpub3dLibFile).absolutePath();
+  const QString partFileName = partFile(type);
+
+  return (QStringList()
+    << (partFileName.isEmpty() ? QString() : QString("%1_%2").arg(partFileName).arg(fileStamp(partFileName)))
+    << fileStamp(Preferences::lpub3dLibFile)
+    << fileStamp(QString("%1/%2").arg(libraryDir).arg(Preferences::validLDrawCustomArchive))
+    << QString("%1_%2_%3").arg(LDrawColor::value(colorCode)).arg(LDrawColor::alpha(colorCode)).arg(LDrawColor::edge(colorCode))
+    << rendererStamp()
+    ).join(QLatin1Char('|'));
+}
+
+QString PliImageStore::storePath(const QString &key)
+{
+  return QDir::toNativeSeparators(QString("%1/pliimages/%2/%3.png")
+                                          .arg(Preferences::lpub3dCachePath)
+                                          .arg(key.left(2))
+                                          .arg(key));
+}
+
+/*
+ * Copy the stored image for key to imageName.
+ * Returns false when the store does not hold the image.
+ */
+bool PliImageStore::restore(const QString &key, const QString &imageName)
+{
+  if (key.isEmpty())
+    return false;
+
+  QMutexLocker locker(&mutex);
+
+  const QString storeFile = storePath(key);
+
+  if (!QFileInfo::exists(storeFile)) {
+    storeMisses++;
+    return false;
+  }
+
+  if (QFileInfo::exists(imageName))
+    QFile::remove(imageName);
+
+  if (!QFile::copy(storeFile, imageName)) {
+    storeMisses++;
+    return false;
+  }
+
+  storeHits++;
+  return true;
+}
+
+/*
+ * Add the rendered image to the store. Existing entries are kept.
+ */
+bool PliImageStore::insert(const QString &key, const QString &imageName)
+{
+  if (key.isEmpty() || !QFileInfo::exists(imageName))
+    return false;
+
+  QMutexLocker locker(&mutex);
+
+  const QString storeFile = storePath(key);
+
+  if (QFileInfo::exists(storeFile))
+    return true;
+
+  if (!QDir().mkpath(QFileInfo(storeFile).absolutePath()))
+    return false;
+
+  // copy to a temporary name first so a partial file is never picked up by another instance
+  const QString tempFile = QString("%1.%2").arg(storeFile).arg(QCoreApplication::applicationPid());
+  if (!QFile::copy(imageName, tempFile))
+    return false;
+
+  if (!QFile::rename(tempFile, storeFile)) {
+    QFile::remove(tempFile);
+    return QFileInfo::exists(storeFile);
+  }
+
+  return true;
+}
+
+/*
+ * Load imageName into pixmap through the process wide decoded image cache.
+ */
+bool PliImageStore::loadPixmap(const QString &imageName, QPixmap *pixmap)
+{
+  return ImageCache::loadPixmap(imageName, pixmap);
+}
+
+/*
+ * Drop the decoded pixmaps of the PLI and BOM part images. CSI and
+ * submodel images stay cached.
+ */
+void PliImageStore::clearPixmaps()
+{
+  ImageCache::remove(QDir::currentPath() + QDir::separator() + Paths::partsDir);
+  ImageCache::remove(QDir::currentPath() + QDir::separator() + Paths::bomDir);
+}
+
+/*
+ * Remove all stored images and decoded pixmaps. Returns the number of removed files.
+ */
+int PliImageStore::clear()
+{
+  clearPixmaps();
+
+  QMutexLocker locker(&mutex);
+
+  int count = 0;
+  QDir storeDir(QDir::toNativeSeparators(QString("%1/pliimages").arg(Preferences::lpub3dCachePath)));
+  if (storeDir.exists()) {
+    const QStringList subDirs = storeDir.entryList(QDir::Dirs | QDir::NoDotAndDotDot);
+    for (const QString &subDir : subDirs) {
+      QDir dir(storeDir.absoluteFilePath(subDir));
+      count += dir.entryList(QDir::Files).size();
+      dir.removeRecursively();
+    }
+  }
+
+  return count;
+}
+
+QString PliImageStore::statistics()
+{
+  QMutexLocker locker(&mutex);
+
+  return QObject::tr("PLI image store: %1 hits, %2 misses")
+                     .arg(storeHits).arg(storeMisses);
+}
@@ -0,0 +1,59 @@
+/****************************************************************************
+**
+** Copyright (C) 2025 Trevor SANDY. All rights reserved.
+**
+** This file may be used under the terms of the
+** GNU General Public Liceense (GPL) version 3.0
+** which accompanies this distribution, and is
+** available at http://www.gnu.org/licenses/gpl.html
+**
+** This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+** WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+**
+****************************************************************************/
+
+/****************************************************************************
+ *
+ * The PLI image store keeps rendered part images in the user cache folder
+ * so they can be shared by every project that uses the same part, colour,
+ * camera, scale and renderer settings. The key includes a content stamp of
+ * the part file, the library archives, the colour definition and the
+ * renderer settings, so an updated or edited part renders again. The
+ * stamp is only taken when the project image is missing. Decoded pixmaps are served from
+ * the process wide ImageCache.
+ *
+ ***************************************************************************/
+
+#ifndef PLIIMAGESTORE_H
+#define PLIIMAGESTORE_H
+
+#include <QString>
+#include <QStringList>
+#include <QPixmap>
+#include <QMutex>
+
+class PliImageStore
+{
+public:
+  PliImageStore() {}
+  static QString key(const QStringList &attributes);
+  static QString contentStamp(const QString &type, const QString &colorCode);
+  static bool restore(const QString &key, const QString &imageName);
+  static bool insert(const QString &key, const QString &imageName);
+  static bool loadPixmap(const QString &imageName, QPixmap *pixmap);
+  static void clearPixmaps();
+  static int  clear();
+  static QString statistics();
+
+private:
+  static QString storePath(const QString &key);
+  static QString fileStamp(const QString &fileName);
+  static QString rendererStamp();
+  static QString partFile(const QString &type);
+
+  static QMutex mutex;
+  static int storeHits;
+  static int storeMisses;
+};
+
+#endif // PLIIMAGESTORE_H
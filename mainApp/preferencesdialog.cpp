@@ -424,6 +424,8 @@ void PreferencesDialog::setPreferences()
   ui.checkUpdateFrequency_Combo->setCurrentIndex(Preferences::checkUpdateFrequency);
   ui.rendererTimeout->setValue(                  Preferences::rendererTimeout);
   ui.pageDisplayPauseSpin->setValue(             Preferences::pageDisplayPause);
+  ui.imageCacheSizeSpin->setValue(               Preferences::imageCacheSize);
+  ui.nativeSoftwareRendererChk->setChecked(      Preferences::nativeSoftwareRenderer);
 
   ui.loadLastOpenedFileCheck->setChecked(        Preferences::loadLastOpenedFile);
   ui.loadLastDisplayedPageCheck->setChecked(     Preferences::loadLastDisplayedPage);
@@ -2285,6 +2287,16 @@ int PreferencesDialog::pageDisplayPause()
   return ui.pageDisplayPauseSpin->value();
 }
 
+int PreferencesDialog::imageCacheSize()
+{
+  return ui.imageCacheSizeSpin->value();
+}
+
+bool PreferencesDialog::nativeSoftwareRenderer()
+{
+  return ui.nativeSoftwareRendererChk->isChecked();
+}
+
 bool PreferencesDialog::showLineParseErrors()
 {
   return mShowLineParseErrors;
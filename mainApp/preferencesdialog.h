@@ -190,6 +190,8 @@ class PreferencesDialog : public QDialog
     int           povrayRenderQuality();
     int           rendererTimeout();
     int           pageDisplayPause();
+    int           imageCacheSize();
+    bool          nativeSoftwareRenderer();
     int           fadeStepsOpacity();
     int           highlightStepLineWidth();
     bool          highlightFirstStep();
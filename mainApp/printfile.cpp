@@ -29,6 +29,7 @@
 #include <QUrl>
 #include <QProcess>
 #include <QErrorMessage>
+#include <QPdfWriter>
 #include <algorithm>
 
 #include <LDVQt/LDVWidget.h>
@@ -54,6 +55,16 @@ bool lessThan(const int &v1, const int &v2)
     return v1 < v2;
 }
 
+// Begin painting page images to pdfWriter. Images are stored with
+// lossless Flate compression or, by default, with JPEG compression.
+static void beginPdfPageImages(QPainter &painter, QPdfWriter &pdfWriter)
+{
+    painter.begin(&pdfWriter);
+#if (QT_VERSION >= QT_VERSION_CHECK(5, 13, 0))
+    painter.setRenderHint(QPainter::LosslessImageRendering, Preferences::pdfPageImageLossless);
+#endif
+}
+
 QPageLayout Gui::getPageLayout(bool nextPage) {
 
   int pageNum = Gui::displayPageNum;
@@ -509,6 +520,12 @@ bool Gui::exportAsDialog(ExportMode m)
         Preferences::pdfPageImage = dialog->pdfPageImage();
         Settings.setValue(QString("%1/%2").arg(DEFAULTS,"PdfPageImage"),Preferences::pdfPageImage);
       }
+
+      if (Gui::m_exportMode == EXPORT_PDF && Preferences::pdfPageImageLossless != dialog->pdfPageImageLossless())
+      {
+        Preferences::pdfPageImageLossless = dialog->pdfPageImageLossless();
+        Settings.setValue(QString("%1/%2").arg(DEFAULTS,"PdfPageImageLossless"),Preferences::pdfPageImageLossless);
+      }
     }
 
   if(Gui::resetCache)
@@ -920,7 +937,7 @@ void Gui::exportAsPdf()
   // set export page elements or image
   bool exportPdfElements = !Preferences::pdfPageImage && dpr == 1.0;
 
-  QString messageIntro = exportPdfElements ? tr("Exporting page ") : tr("Step 1. Creating image for page ");
+  QString messageIntro = exportPdfElements ? tr("Exporting page ") : tr("Exporting image for page ");
 
   // instantiate the scene and view
   gui->KexportScene = LGraphicsScene(gui);
@@ -953,15 +970,6 @@ void Gui::exportAsPdf()
   _displayPageNum = 0;
   _maxPages       = 0;
 
-  // page store
-  struct PdfPage {
-      QImage image;
-      float pageWidthIn;
-      float pageHeightIn;
-      QPageLayout pageLayout;
-  };
-  QMap<int, PdfPage> pages;
-
   if (Gui::processOption != EXPORT_PAGE_RANGE) {
 
       if(Gui::processOption == EXPORT_ALL_PAGES) {
@@ -989,18 +997,23 @@ void Gui::exportAsPdf()
       // set initial pdfWriter page layout
       pdfWriter.setPageLayout(getPageLayout());
 
-      QPainter painter;
+      QPainter painter, pdfPainter;
       if (exportPdfElements) {
          // initialize painter with pdfWriter
          painter.begin(&pdfWriter);
+      } else {
+         // initialize page image painter with pdfWriter
+         beginPdfPageImages(pdfPainter, pdfWriter);
       }
 
-      // step 1. generate page pixmaps
+      // generate pages
       for (Gui::displayPageNum = _displayPageNum; Gui::displayPageNum <= _maxPages; Gui::displayPageNum++) {
 
           if (! Gui::exporting()) {
               if (exportPdfElements)
                   painter.end();
+              else
+                  pdfPainter.end();
               message = tr("Export to pdf terminated before completion. %1 pages of %2 processed%3.")
                            .arg(Gui::displayPageNum - 1).arg(_maxPages).arg(gui->elapsedTime(exportTimer.elapsed()));
               emit gui->messageSig(LOG_INFO_STATUS,message);
@@ -1044,9 +1057,12 @@ void Gui::exportAsPdf()
                        .arg(messageIntro);
           emit gui->messageSig(LOG_NOTICE,message);
 
-          // initiialize the image
-          QImage image(adjPageWidthPx, adjPageHeightPx, QImage::Format_ARGB32);
-          image.setDevicePixelRatio(dpr);
+          // initiialize the image - only used for page image export
+          QImage image;
+          if (!exportPdfElements) {
+              image = QImage(adjPageWidthPx, adjPageHeightPx, QImage::Format_RGB32);
+              image.setDevicePixelRatio(dpr);
+          }
 
           // set up the view - use unscaled page size
           QRectF boundingRect(0.0, 0.0, int(pageWidthPx),int(pageHeightPx));
@@ -1086,89 +1102,34 @@ void Gui::exportAsPdf()
                   pdfWriter.newPage();
               }
           } else {
-              // store the image and required page attributes
+              // wrap up paint to image
+              painter.end();
+
+              // write the page image now so only the current page image is held in memory
               gui->getExportPageSize(pageWidthIn, pageHeightIn, Inches);
-              PdfPage pdfPage;
-              pdfPage.image       = image;
-              pdfPage.pageWidthIn  = pageWidthIn;
-              pdfPage.pageHeightIn = pageHeightIn;
+              pdfPainter.drawImage(QRect(0,0,
+                                   int(pdfWriter.logicalDpiX()*pageWidthIn),
+                                   int(pdfWriter.logicalDpiY()*pageHeightIn)),
+                                   image);
+              image = QImage();
 
-              // store pdfWriter next page layout
+              // prepare pdfWriter to render next page
               if(Gui::displayPageNum < _maxPages) {
                   bool nextPage = true;
-                  pdfPage.pageLayout = getPageLayout(nextPage);
+                  pdfWriter.setPageLayout(getPageLayout(nextPage));
+                  pdfWriter.newPage();
               }
-
-              // store the rendered page
-              QMap<int, PdfPage>::iterator i = pages.find(Gui::displayPageNum);
-              if (i != pages.end())
-                  pages.erase(i);
-              pages.insert(Gui::displayPageNum,pdfPage);
-
-              // wrap up paint to image
-              painter.end();
           }
-      } // end of step 1. generate page pixmaps
+      } // end of generate pages
 
       if (Preferences::modeGUI)
           gui->m_progressDialog->setValue(_maxPages);
 
-      if (exportPdfElements) {
-          // wrap up paint to pdfWriter
+      // wrap up paint to pdfWriter
+      if (exportPdfElements)
           painter.end();
-      } else {
-          // step 2. paint generated page pixmaps to the pdfWriter
-          painter.begin(&pdfWriter);
-
-          if (Preferences::modeGUI)
-              gui->m_progressDialog->setRange(1,pages.count());
-
-          for (int page : pages.keys()) {
-
-              message = tr("Step 2. Exporting pdf document page %1 of %2").arg(page).arg(pages.count());
-              emit gui->messageSig(LOG_INFO_STATUS,message);
-
-              if (Preferences::modeGUI) {
-                  gui->m_progressDialog->setLabelText(message);
-                  gui->m_progressDialog->setValue(page);
-                  QApplication::processEvents();
-              }
-
-              if (! Gui::exporting()) {
-                  painter.end();
-                  message = tr("Export to pdf terminated before completion. %2 pages of %3 processed%4.")
-                                .arg(page).arg(pages.count()).arg(Gui::elapsedTime(exportTimer.elapsed()));
-                  emit gui->messageSig(LOG_INFO_STATUS,message);
-                  if (Preferences::modeGUI) {
-                      QApplication::restoreOverrideCursor();
-                      gui->m_progressDialog->setBtnToClose();
-                      gui->m_progressDialog->setLabelText(message, true/*alert*/);
-                  }
-                  emit gui->setExportingSig(false);
-                  restoreCurrentPage();
-                  return;
-              }
-
-              // render this page's image to the pdfWriter
-              painter.drawImage(QRect(0,0,
-                                       int(pdfWriter.logicalDpiX()*pages[page].pageWidthIn),
-                                       int(pdfWriter.logicalDpiY()*pages[page].pageHeightIn)),
-                                       pages[page].image);
-
-              // prepare to render next page
-              if(page < pages.count()) {
-                  pdfWriter.setPageLayout(pages[page].pageLayout);
-                  pdfWriter.newPage();
-              }
-          }
-
-          if (Preferences::modeGUI)
-              gui->m_progressDialog->setValue(pages.count());
-
-          // wrap up paint to pdfWriter
-          pages.clear();
-          painter.end();
-      }
+      else
+          pdfPainter.end();
 
   } else {
 
@@ -1206,13 +1167,16 @@ void Gui::exportAsPdf()
       // set initial pdfWriter page layout
       pdfWriter.setPageLayout(getPageLayout());
 
-      QPainter painter;
+      QPainter painter, pdfPainter;
       if (exportPdfElements) {
          // initialize painter with pdfWriter
          painter.begin(&pdfWriter);
+      } else {
+         // initialize page image painter with pdfWriter
+         beginPdfPageImages(pdfPainter, pdfWriter);
       }
 
-      // step 1. generate page pixmaps
+      // generate pages
       for (int printPage : printPages) {
 
           _pageCount++;
@@ -1220,6 +1184,8 @@ void Gui::exportAsPdf()
           if (! Gui::exporting()) {
               if (exportPdfElements)
                   painter.end();
+              else
+                  pdfPainter.end();
               message = tr("Export to pdf terminated before completion. %2 pages of %3 processed%4.")
                             .arg(_pageCount).arg(printPages.count()).arg(Gui::elapsedTime(exportTimer.elapsed()));
               emit gui->messageSig(LOG_INFO_STATUS,message);
@@ -1267,9 +1233,12 @@ void Gui::exportAsPdf()
                        .arg(int(resolution()));              //9
           emit gui->messageSig(LOG_NOTICE,message);
 
-          // initiialize the image
-          QImage image(adjPageWidthPx, adjPageHeightPx, QImage::Format_ARGB32);
-          image.setDevicePixelRatio(dpr);
+          // initiialize the image - only used for page image export
+          QImage image;
+          if (!exportPdfElements) {
+              image = QImage(adjPageWidthPx, adjPageHeightPx, QImage::Format_RGB32);
+              image.setDevicePixelRatio(dpr);
+          }
 
           // set up the view - use unscaled page size
           QRectF boundingRect(0.0, 0.0, int(pageWidthPx),int(pageHeightPx));
@@ -1309,90 +1278,34 @@ void Gui::exportAsPdf()
                   pdfWriter.newPage();
               }
           } else {
-              // store the image and required page attributes
+              // wrap up paint to image
+              painter.end();
+
+              // write the page image now so only the current page image is held in memory
               gui->getExportPageSize(pageWidthIn, pageHeightIn, Inches);
-              PdfPage pdfPage;
-              pdfPage.image       = image;
-              pdfPage.pageWidthIn  = pageWidthIn;
-              pdfPage.pageHeightIn = pageHeightIn;
+              pdfPainter.drawImage(QRect(0,0,
+                                   int(pdfWriter.logicalDpiX()*pageWidthIn),
+                                   int(pdfWriter.logicalDpiY()*pageHeightIn)),
+                                   image);
+              image = QImage();
 
-              // store pdfWriter next page layout
+              // prepare pdfWriter to render next page
               if(_pageCount < printPages.count()) {
                   bool nextPage = true;
-                  pdfPage.pageLayout = getPageLayout(nextPage);
+                  pdfWriter.setPageLayout(getPageLayout(nextPage));
+                  pdfWriter.newPage();
               }
-
-              // store the rendered page
-              QMap<int, PdfPage>::iterator i = pages.find(Gui::displayPageNum);
-              if (i != pages.end())
-                  pages.erase(i);
-              pages.insert(Gui::displayPageNum,pdfPage);
-
-              // wrap up
-              painter.end();
           }
-      } // end of step 1. generate page pixmaps
+      } // end of generate pages
 
       if (Preferences::modeGUI)
           gui->m_progressDialog->setValue(printPages.count());
 
-      if (exportPdfElements) {
-          // wrap up paint to pdfWriter
+      // wrap up paint to pdfWriter
+      if (exportPdfElements)
           painter.end();
-      } else {
-          // step 2. paint generated page pixmaps to the pdfWriter
-          painter.begin(&pdfWriter);
-
-          if (Preferences::modeGUI)
-              gui->m_progressDialog->setRange(1,pages.count());
-
-          int page;
-          Q_FOREACH (page, pages.keys()) {
-
-              message = tr("Step 2. Exporting pdf document page %1 of %2").arg(page).arg(pages.count());
-              emit gui->messageSig(LOG_INFO_STATUS,message);
-
-              if (Preferences::modeGUI) {
-                  gui->m_progressDialog->setLabelText(message);
-                  gui->m_progressDialog->setValue(page);
-                  QApplication::processEvents();
-              }
-
-              if (! Gui::exporting()) {
-                  painter.end();
-                  message = tr("Export to pdf terminated before completion. %2 pages of %3 processed%4.")
-                                .arg(page).arg(pages.count()).arg(Gui::elapsedTime(exportTimer.elapsed()));
-                  emit gui->messageSig(LOG_INFO_STATUS,message);
-                  if (Preferences::modeGUI) {
-                      QApplication::restoreOverrideCursor();
-                      gui->m_progressDialog->setBtnToClose();
-                      gui->m_progressDialog->setLabelText(message, true/*alert*/);
-                  }
-                  emit gui->setExportingSig(false);
-                  restoreCurrentPage();
-                  return;
-              }
-
-              // render this page's image to the pdfWriter
-              painter.drawImage(QRect(0,0,
-                                 int(pdfWriter.logicalDpiX()*pages[page].pageWidthIn),
-                                 int(pdfWriter.logicalDpiY()*pages[page].pageHeightIn)),
-                                 pages[page].image);
-
-              // prepare to render next page
-              if(page < pages.count()) {
-                  pdfWriter.setPageLayout(pages[page].pageLayout);
-                  pdfWriter.newPage();
-              }
-          }
-
-          if (Preferences::modeGUI)
-              gui->m_progressDialog->setValue(pages.count());
-
-          // wrap up paint to pdfWriter
-          pages.clear();
-          painter.end();
-      } // end of step 2. paint generated page pixmaps to the pdfWriter
+      else
+          pdfPainter.end();
   }
 
   // hide progress bar
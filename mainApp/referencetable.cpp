@@ -0,0 +1,222 @@
+/****************************************************************************
+**
+** Copyright (C) 2025 Trevor SANDY. All rights reserved.
+**
+** This file may be used under the terms of the
+** GNU General Public Liceense (GPL) version 3.0
+** which accompanies this distribution, and is
+** available at http://www.gnu.org/licenses/gpl.html
+**
+** This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+** WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+**
+****************************************************************************/
+
+#include "referencetable.h"
+
+#include <QDir>
+#include <QFileInfo>
+#include <QDateTime>
+#include <QSaveFile>
+#include <QVector>
+
+#include <algorithm>
+#include <cstring>
+
+/*
+ * File layout, quint32 values in host byte order:
+ *
+ *   magic, version, columns, rows, stamp size
+ *   stamp bytes, padded to 4 bytes
+ *   index: rows x (1 + columns) x (pool offset, length), key first
+ *   pool:  UTF-16 strings, keys in lower case
+ */
+static const quint32 ReferenceTableMagic   = 0x5452504c; // 'LPRT'
+static const quint32 ReferenceTableVersion = 1;
+static const int     ReferenceTableHeader  = 5 * sizeof(quint32);
+
+ReferenceTable::~ReferenceTable()
+{
+  close();
+}
+
+QByteArray ReferenceTable::fileStamp(const QString &fileName)
+{
+  const QFileInfo fileInfo(fileName);
+  return QString("%1|%2|%3;").arg(fileInfo.absoluteFilePath())
+                             .arg(fileInfo.size())
+                             .arg(fileInfo.lastModified().toMSecsSinceEpoch()).toUtf8();
+}
+
+void ReferenceTable::close()
+{
+  if (data)
+    file.unmap(const_cast<uchar *>(data));
+  if (file.isOpen())
+    file.close();
+
+  data        = nullptr;
+  index       = nullptr;
+  pool        = nullptr;
+  rowCount    = 0;
+  columnCount = 0;
+}
+
+/*
+ * Map fileName when it is a valid table compiled from sources matching stamp.
+ */
+bool ReferenceTable::open(const QString &fileName, const QByteArray &stamp)
+{
+  close();
+
+  file.setFileName(fileName);
+  if (!file.exists() || !file.open(QIODevice::ReadOnly))
+    return false;
+
+  const qint64 fileSize = file.size();
+  const uchar *mapped = fileSize > ReferenceTableHeader ? file.map(0, fileSize) : nullptr;
+  if (!mapped) {
+    file.close();
+    return false;
+  }
+
+  const quint32 *header = reinterpret_cast<const quint32 *>(mapped);
+  const quint32 stampSize = header[4];
+  const qint64 stampEnd = ReferenceTableHeader + ((qint64(stampSize) + 3) & ~qint64(3));
+  const qint64 indexSize = qint64(header[3]) * (1 + header[2]) * 2 * sizeof(quint32);
+
+  bool valid = header[0] == ReferenceTableMagic &&
+               header[1] == ReferenceTableVersion &&
+               header[2] > 0 &&
+               stampEnd + indexSize <= fileSize &&
+               stampSize == quint32(stamp.size()) &&
+               memcmp(mapped + ReferenceTableHeader, stamp.constData(), stampSize) == 0;
+
+  // every string must lie within the pool, a truncated or corrupt file is rebuilt
+  if (valid) {
+    const quint32 *entries = reinterpret_cast<const quint32 *>(mapped + stampEnd);
+    const qint64 poolSize = (fileSize - stampEnd - indexSize) / qint64(sizeof(ushort));
+    const qint64 entryCount = qint64(header[3]) * (1 + header[2]);
+    for (qint64 i = 0; i < entryCount && valid; i++)
+      valid = qint64(entries[i * 2]) + qint64(entries[i * 2 + 1]) <= poolSize;
+  }
+
+  if (!valid) {
+    file.unmap(const_cast<uchar *>(mapped));
+    file.close();
+    return false;
+  }
+
+  data        = mapped;
+  columnCount = header[2];
+  rowCount    = header[3];
+  index       = reinterpret_cast<const quint32 *>(mapped + stampEnd);
+  pool        = reinterpret_cast<const ushort *>(mapped + stampEnd + indexSize);
+
+  return true;
+}
+
+/*
+ * Write rows, keyed in lower case, to fileName and map the result.
+ */
+bool ReferenceTable::create(const QString &fileName, const QByteArray &stamp, const QHash<QString, QStringList> &rows, int columns)
+{
+  close();
+
+  if (columns < 1 || !QDir().mkpath(QFileInfo(fileName).absolutePath()))
+    return false;
+
+  QStringList keys = rows.keys();
+  std::sort(keys.begin(), keys.end());
+
+  QVector<quint32> tableIndex;
+  tableIndex.reserve(keys.size() * (1 + columns) * 2);
+  QVector<ushort> tablePool;
+
+  auto addString = [&tableIndex, &tablePool] (const QString &string)
+  {
+    tableIndex << quint32(tablePool.size()) << quint32(string.size());
+    for (const QChar &c : string)
+      tablePool << c.unicode();
+  };
+
+  for (const QString &key : keys) {
+    addString(key);
+    const QStringList &values = rows[key];
+    for (int column = 0; column < columns; column++)
+      addString(column < values.size() ? values.at(column) : QString());
+  }
+
+  const quint32 header[5] = { ReferenceTableMagic, ReferenceTableVersion, quint32(columns), quint32(keys.size()), quint32(stamp.size()) };
+  QByteArray stampBytes = stamp;
+  while (stampBytes.size() % 4)
+    stampBytes.append('\0');
+
+  QSaveFile saveFile(fileName);
+  if (!saveFile.open(QIODevice::WriteOnly))
+    return false;
+
+  saveFile.write(reinterpret_cast<const char *>(header), sizeof(header));
+  saveFile.write(stampBytes);
+  saveFile.write(reinterpret_cast<const char *>(tableIndex.constData()), tableIndex.size() * sizeof(quint32));
+  saveFile.write(reinterpret_cast<const char *>(tablePool.constData()), tablePool.size() * sizeof(ushort));
+
+  if (!saveFile.commit())
+    return false;
+
+  return open(fileName, stamp);
+}
+
+// compare the key of row with the lower case concatenation of first and second
+int ReferenceTable::compare(int row, const QString &first, const QString &second) const
+{
+  const quint32 *entry = index + qint64(row) * (1 + columnCount) * 2;
+  const ushort *key = pool + entry[0];
+  const int keySize = int(entry[1]);
+  const int querySize = first.size() + second.size();
+
+  for (int i = 0; i < keySize && i < querySize; i++) {
+    const QChar c = i < first.size() ? first.at(i) : second.at(i - first.size());
+    const ushort q = c.toLower().unicode();
+    if (key[i] != q)
+      return key[i] < q ? -1 : 1;
+  }
+
+  return keySize - querySize;
+}
+
+/*
+ * Binary search for the key first + second. Returns the row or -1.
+ */
+int ReferenceTable::find(const QString &first, const QString &second) const
+{
+  if (!data)
+    return -1;
+
+  int low = 0, high = int(rowCount) - 1;
+  while (low <= high) {
+    const int middle = low + (high - low) / 2;
+    const int result = compare(middle, first, second);
+    if (result == 0)
+      return middle;
+    if (result < 0)
+      low = middle + 1;
+    else
+      high = middle - 1;
+  }
+
+  return -1;
+}
+
+/*
+ * Return the value of column for row. The string references the mapped
+ * pool, so it must not outlive the table.
+ */
+QString ReferenceTable::value(int row, int column) const
+{
+  if (!data || row < 0 || row >= int(rowCount) || column < 0 || column >= int(columnCount))
+    return QString();
+
+  const quint32 *entry = index + (qint64(row) * (1 + columnCount) + 1 + column) * 2;
+  return QString::fromRawData(reinterpret_cast<const QChar *>(pool + entry[0]), int(entry[1]));
+}
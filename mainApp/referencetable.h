@@ -0,0 +1,79 @@
+/****************************************************************************
+**
+** Copyright (C) 2025 Trevor SANDY. All rights reserved.
+**
+** This file may be used under the terms of the
+** GNU General Public Liceense (GPL) version 3.0
+** which accompanies this distribution, and is
+** available at http://www.gnu.org/licenses/gpl.html
+**
+** This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+** WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+**
+****************************************************************************/
+
+/****************************************************************************
+ *
+ * Compiled lookup table for the Annotations reference files.
+ *
+ * The parsed rows of a reference file are written once to the user cache
+ * folder as a sorted key table and a UTF-16 string pool. Later sessions map
+ * the file and look keys up with a binary search, so no text is parsed and
+ * no hash is built. The table carries a stamp of its source files and is
+ * rebuilt when a source changes.
+ *
+ ***************************************************************************/
+
+#ifndef REFERENCETABLE_H
+#define REFERENCETABLE_H
+
+#include <QFile>
+#include <QHash>
+#include <QString>
+#include <QStringList>
+#include <QByteArray>
+
+class ReferenceTable
+{
+public:
+  ReferenceTable() {}
+  ~ReferenceTable();
+
+  ReferenceTable(const ReferenceTable &) = delete;
+  ReferenceTable &operator=(const ReferenceTable &) = delete;
+
+  bool open(const QString &fileName, const QByteArray &stamp);
+  bool create(const QString &fileName, const QByteArray &stamp, const QHash<QString, QStringList> &rows, int columns);
+  void close();
+
+  bool isOpen() const
+  {
+    return data != nullptr;
+  }
+
+  int size() const
+  {
+    return int(rowCount);
+  }
+
+  int find(const QString &key) const
+  {
+    return find(key, QString());
+  }
+  int find(const QString &first, const QString &second) const;
+  QString value(int row, int column = 0) const;
+
+  static QByteArray fileStamp(const QString &fileName);
+
+private:
+  int compare(int row, const QString &first, const QString &second) const;
+
+  QFile file;
+  const uchar *data = nullptr;
+  const quint32 *index = nullptr;
+  const ushort *pool = nullptr;
+  quint32 rowCount = 0;
+  quint32 columnCount = 0;
+};
+
+#endif // REFERENCETABLE_H
@@ -72,6 +72,7 @@ LDGLite ldglite;
 LDView  ldview;
 POVRay  povray;
 Native  native;
+NativeRenderSession nativeSession;
 
 const QString nativeExportNames[] =
 {
@@ -984,14 +985,14 @@ int POVRay::renderCsi(
 #endif
 
       bool retError = false;
-      ldvWidget = new LDVWidget(nullptr,NativePOVIni,true);
+      ldvWidget = LDVWidget::nativeExportSession(NativePOVIni);
       if (! ldvWidget->doCommand(arguments))  {
           emit gui->messageSig(LOG_ERROR, QObject::tr("Failed to generate CSI POV file for command: %1").arg(arguments.join(" ")));
           retError = true;
       }
 
-      // ldvWidget changes the Working directory so we must reset
-      if (! QDir::setCurrent(workingDirectory)) {
+      // ldvWidget may change the Working directory so we must reset
+      if (QDir::currentPath() != workingDirectory && ! QDir::setCurrent(workingDirectory)) {
           emit gui->messageSig(LOG_ERROR, QObject::tr("Failed to restore CSI POV working directory %1").arg(workingDirectory));
           retError = true;
       }
@@ -1365,14 +1366,14 @@ int POVRay::renderPli(
 #endif
 
       bool retError = false;
-      ldvWidget = new LDVWidget(nullptr,NativePOVIni,true);
+      ldvWidget = LDVWidget::nativeExportSession(NativePOVIni);
       if (! ldvWidget->doCommand(arguments)) {
           emit gui->messageSig(LOG_ERROR, QObject::tr("Failed to generate PLI POV file for command: %1").arg(arguments.join(" ")));
           retError = true;
       }
 
-      // ldvWidget changes the Working directory so we must reset
-      if (! QDir::setCurrent(workingDirectory)) {
+      // ldvWidget may change the Working directory so we must reset
+      if (QDir::currentPath() != workingDirectory && ! QDir::setCurrent(workingDirectory)) {
           emit gui->messageSig(LOG_ERROR, QObject::tr("Failed to restore PLI POV working directory %1").arg(workingDirectory));
           retError = true;
       }
@@ -3511,11 +3512,20 @@ bool Render::RenderNativeView(const NativeOptions *O, bool RenderImage/*false*/)
 
     if (!DefaultCamera)
     {
+        lcCamera *ResidentCamera = nullptr;
+
         for (size_t CameraIndex = 0; CameraIndex < ActiveModel->GetCameras().size(); )
         {
             QString const Name = ActiveModel->GetCameras()[CameraIndex]->GetName();
             if (Name == O->CameraName)
             {
+                // The native render session keeps the previous render model
+                // loaded, so its camera is updated in place
+                if (RenderImage)
+                {
+                    ResidentCamera = ActiveModel->GetCameras()[CameraIndex];
+                    break;
+                }
                 ActiveModel->RemoveCameraIndex(CameraIndex);
                 QStringList const keys = O->ViewerStepKey.split(";");
                 emit gui->messageSig(LOG_NOTICE, QObject::tr("Existing camera %1%2 was removed.")
@@ -3533,7 +3543,15 @@ bool Render::RenderNativeView(const NativeOptions *O, bool RenderImage/*false*/)
         CameraZFar = Camera->m_zFar;
         CameraZNear = Camera->m_zNear;
 
-        ActiveModel->AddCamera(Camera);
+        if (ResidentCamera)
+        {
+            ResidentCamera->CopyCamera(Camera);
+            delete Camera;
+        }
+        else
+        {
+            ActiveModel->AddCamera(Camera);
+        }
 
         Camera = nullptr;
 
@@ -3559,41 +3577,21 @@ bool Render::RenderNativeView(const NativeOptions *O, bool RenderImage/*false*/)
         ImageWidth   = int(O->PageWidth);
         ImageHeight  = int(UseImageSize ? O->PageHeight / 2 : O->PageHeight);
 
-        const lcStep CurrentStep = ActiveModel->GetCurrentStep();
-        const lcStep ImageStep   = ActiveModel->GetLastStep();
-
-        std::unique_ptr<lcView> ImageView = std::unique_ptr<lcView>(new lcView(lcViewType::View, ActiveModel));
-
-        if (DefaultCamera)
-            ImageView->SetCamera(Camera, true);
-        else
-            ImageView->SetCamera(O->CameraName);
-        ImageView->SetProjection(IsOrtho);
-        ImageView->SetOffscreenContext();
-        ImageView->MakeCurrent();
-
-        if ((rc = ImageView->BeginRenderToImage(ImageWidth, ImageHeight)))
+        struct NativeImage
+        {
+            QImage RenderedImage;
+            QRect Bounds;
+        };
+        NativeImage Image;
+
+        if ((rc = nativeSession.RenderImage(ActiveModel,
+                                            DefaultCamera ? Camera : nullptr,
+                                            O->CameraName,
+                                            IsOrtho,
+                                            ImageWidth,
+                                            ImageHeight,
+                                            Image.RenderedImage)))
         {
-            struct NativeImage
-            {
-                QImage RenderedImage;
-                QRect Bounds;
-            };
-            NativeImage Image;
-
-            ActiveModel->SetTemporaryStep(ImageStep);
-
-            ImageView->OnDraw();
-
-            Image.RenderedImage = ImageView->GetRenderImage();
-
-            ImageView->EndRenderToImage();
-
-            ActiveModel->SetTemporaryStep(CurrentStep);
-
-            if (!ActiveModel->IsActive())
-                ActiveModel->CalculateStep(LC_STEP_MAX);
-
             auto CalculateImageBounds = [&O, &UseImageSize](NativeImage& Image)
             {
                 QImage& RenderedImage = Image.RenderedImage;
@@ -3835,11 +3833,329 @@ bool Render::RenderNativeImage(const NativeOptions *Options)
         emit gui->messageSig(LOG_ERROR, QObject::tr("Could not open Loader for ViewerStepKey: '%1', FileName: '%2', [Use File]")
                                                     .arg(Options->ViewerStepKey)
                                                     .arg(QFileInfo(Options->InputFileName).fileName()));
+    } else if (Preferences::debugLogging) {
+        emit gui->messageSig(LOG_DEBUG, nativeSession.statistics());
     }
 
     return Loaded;
 }
 
+/****************************************************************************
+ *
+ * Native render session
+ *
+ ***************************************************************************/
+
+QString const NativeRenderSession::settingsKey(const NativeOptions *Options)
+{
+    return QString("%1_%2_%3_%4_%5_%6_%7_%8_%9")
+                   .arg(Options->ImageType)
+                   .arg(Options->LPubFadeHighlight)
+                   .arg(Options->FadeParts)
+                   .arg(Options->HighlightParts)
+                   .arg(Options->StudStyle)
+                   .arg(double(Options->LightDarkIndex))
+                   .arg(Options->AutoEdgeColor)
+                   .arg(double(Options->EdgeContrast))
+                   .arg(double(Options->EdgeSaturation))
+         + QString("_%1_%2_%3_%4_%5_%6_%7_%8")
+                   .arg(Options->StudCylinderColorEnabled)
+                   .arg(Options->StudCylinderColor)
+                   .arg(Options->PartEdgeColorEnabled)
+                   .arg(Options->PartEdgeColor)
+                   .arg(Options->BlackEdgeColorEnabled)
+                   .arg(Options->BlackEdgeColor)
+                   .arg(Options->DarkEdgeColorEnabled)
+                   .arg(Options->DarkEdgeColor);
+}
+
+/*
+ * The render content without the LDraw file header and the trailing
+ * NOFILE line. The header names the step file, so it changes between
+ * steps that otherwise only add part lines, and it is not rendered.
+ */
+QByteArray const NativeRenderSession::contentBody(const QByteArray &content)
+{
+    static const char *const headerMeta[] = {
+        "0 FILE ", "0 Name:", "0 Author:", "0 !LDRAW_ORG ", "0 !LICENSE ", "0 BFC CERTIFY "
+    };
+
+    auto isHeaderMeta = [] (const QByteArray &line)
+    {
+        for (const char *meta : headerMeta)
+            if (line.startsWith(meta))
+                return true;
+        return false;
+    };
+
+    // the header is the leading comment block up to its last header meta,
+    // which includes the description line between FILE and Name:
+    int bodyStart = 0;
+    for (int from = 0; from < content.size() && content.mid(from, 2) == "0 ";) {
+        int next = content.indexOf('\n', from);
+        next = next < 0 ? content.size() : next + 1;
+        if (isHeaderMeta(content.mid(from, next - from)))
+            bodyStart = next;
+        from = next;
+    }
+
+    QByteArray body = content.mid(bodyStart);
+
+    while (body.endsWith('\n') || body.endsWith('\r'))
+        body.chop(1);
+    if (body.endsWith("\n0 NOFILE")) {
+        body.chop(8);
+        while (body.endsWith('\n') || body.endsWith('\r'))
+            body.chop(1);
+    }
+
+    return body;
+}
+
+bool NativeRenderSession::LoadProject(const NativeOptions *Options)
+{
+    QFile file(Options->InputFileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        reset();
+        return fullLoad(Options);
+    }
+
+    const QByteArray content = contentBody(file.readAll());
+    file.close();
+
+    const QString key = settingsKey(Options);
+
+    Project *ActiveProject = lcGetActiveProject();
+
+    bool resident = mProjectSerial && ActiveProject &&
+                    ActiveProject->GetSerial() == mProjectSerial &&
+                    mSettingsKey == key;
+
+    if (resident) {
+        if (content == mContent) {
+            mReuses++;
+            return true;
+        }
+
+        // consecutive steps without fade or highlight usually only add part lines
+        bool canApplyDelta = !Options->FadeParts && !Options->HighlightParts &&
+                             ActiveProject->GetModels().size() == 1 &&
+                             content.size() > mContent.size() &&
+                             content.startsWith(mContent) &&
+                             (content.at(mContent.size()) == '\n' ||
+                              content.at(mContent.size()) == '\r');
+
+        if (canApplyDelta && applyDelta(content.mid(mContent.size()))) {
+            mContent = content;
+            mDeltaLoads++;
+            return true;
+        }
+    }
+
+    if (!fullLoad(Options)) {
+        reset();
+        return false;
+    }
+
+    mContent       = content;
+    mSettingsKey   = key;
+    mProjectSerial = lcGetActiveProject()->GetSerial();
+
+    return true;
+}
+
+bool NativeRenderSession::fullLoad(const NativeOptions *Options)
+{
+    Project *Loader = new Project(false/*IsPreview*/, NATIVE_IMAGE);
+
+    if (Options->LPubFadeHighlight)
+        Loader->SetLPubFadeHighlightParts(
+            Options->FadeParts,
+            Options->HighlightParts);
+
+    if (!Loader->Load(Options->InputFileName, QString()/*StepKey*/, Options->ImageType, false/*ShowErrors*/)) {
+        delete Loader;
+        return false;
+    }
+
+    gApplication->SetProject(Loader);
+    lcView::UpdateProjectViews(Loader);
+
+    mFullLoads++;
+
+    return true;
+}
+
+bool NativeRenderSession::applyDelta(const QByteArray &delta)
+{
+    Project *ActiveProject = lcGetActiveProject();
+    lcModel *ActiveModel = ActiveProject->GetMainModel();
+    if (!ActiveModel)
+        return false;
+
+    QStringList lines = QString::fromUtf8(delta).split(QRegularExpression("(\\r\\n)|\\n"), SkipEmptyParts);
+    if (!ActiveModel->AppendLDrawPieces(lines, ActiveProject))
+        return false;
+
+    std::vector<lcModel*> UpdatedModels;
+    ActiveModel->UpdatePieceInfo(UpdatedModels);
+
+    return true;
+}
+
+#ifdef QT_DEBUG_MODE
+/*
+ * Compare a software render with the OpenGL framebuffer render of the same
+ * view. A pixel differs when any channel is off by more than the tolerance,
+ * which allows for antialiasing and rasterization rule differences at edges.
+ */
+static QString nativeSoftwareRenderDifference(const QImage &softwareImage, const QImage &referenceImage)
+{
+    const int channelTolerance = 16;       // per channel, 0-255
+    const double pixelTolerance = 1.0;     // percent of differing pixels
+
+    if (softwareImage.size() != referenceImage.size())
+        return QObject::tr("Native software render size %1x%2 does not match OpenGL render size %3x%4.")
+                           .arg(softwareImage.width()).arg(softwareImage.height())
+                           .arg(referenceImage.width()).arg(referenceImage.height());
+
+    const QImage software  = softwareImage.convertToFormat(QImage::Format_ARGB32);
+    const QImage reference = referenceImage.convertToFormat(QImage::Format_ARGB32);
+
+    qint64 channelSum = 0;
+    qint64 differingPixels = 0;
+    int channelMax = 0;
+
+    for (int y = 0; y < software.height(); y++) {
+        const QRgb *s = reinterpret_cast<const QRgb *>(software.constScanLine(y));
+        const QRgb *r = reinterpret_cast<const QRgb *>(reference.constScanLine(y));
+        for (int x = 0; x < software.width(); x++) {
+            const int d[4] = {
+                qAbs(qRed(s[x])   - qRed(r[x])),
+                qAbs(qGreen(s[x]) - qGreen(r[x])),
+                qAbs(qBlue(s[x])  - qBlue(r[x])),
+                qAbs(qAlpha(s[x]) - qAlpha(r[x]))
+            };
+            const int pixelMax = qMax(qMax(d[0], d[1]), qMax(d[2], d[3]));
+            channelSum += d[0] + d[1] + d[2] + d[3];
+            channelMax = qMax(channelMax, pixelMax);
+            if (pixelMax > channelTolerance)
+                differingPixels++;
+        }
+    }
+
+    const qint64 pixels = qint64(software.width()) * software.height();
+    const double meanDifference = pixels ? double(channelSum) / (pixels * 4) : 0.0;
+    const double differingPercent = pixels ? 100.0 * differingPixels / pixels : 0.0;
+
+    return QObject::tr("Native software render difference from OpenGL: mean %1, max %2, %3% of pixels beyond %4 - %5 tolerance.")
+                       .arg(meanDifference, 0, 'f', 2).arg(channelMax)
+                       .arg(differingPercent, 0, 'f', 2).arg(channelTolerance)
+                       .arg(differingPercent <= pixelTolerance ? QObject::tr("within") : QObject::tr("outside"));
+}
+#endif
+
+bool NativeRenderSession::RenderImage(
+    lcModel *Model,
+    lcCamera *Camera,
+    const QString &CameraName,
+    bool IsOrtho,
+    int Width,
+    int Height,
+    QImage &Image)
+{
+    const lcStep CurrentStep = Model->GetCurrentStep();
+    const lcStep ImageStep   = Model->GetLastStep();
+
+    std::unique_ptr<lcView> ImageView = std::unique_ptr<lcView>(new lcView(lcViewType::View, Model));
+
+    if (Camera)
+        ImageView->SetCamera(Camera, true);
+    else
+        ImageView->SetCamera(CameraName);
+    ImageView->SetProjection(IsOrtho);
+
+    // Rasterize on the CPU when requested, when there is no OpenGL context,
+    // e.g. on headless machines without a usable GPU, or when the OpenGL
+    // framebuffer cannot be created.
+    const bool HasOpenGL = lcContext::HasOffscreenContext();
+    bool Software = Preferences::nativeSoftwareRenderer || !HasOpenGL;
+
+    if (!Software) {
+        ImageView->SetOffscreenContext();
+        ImageView->MakeCurrent();
+        ImageView->SetReuseRenderFramebuffer(true);
+
+        if (!ImageView->BeginRenderToImage(Width, Height)) {
+            emit gui->messageSig(LOG_NOTICE, QObject::tr("Could not begin OpenGL render to image, using the native software renderer."));
+            Software = true;
+        }
+    }
+
+    Model->SetTemporaryStep(ImageStep);
+
+    bool Rendered = true;
+
+    if (Software) {
+        QElapsedTimer Timer;
+        Timer.start();
+
+        Rendered = ImageView->RenderToImageSoftware(Width, Height);
+
+        if (Preferences::debugLogging)
+            emit gui->messageSig(LOG_DEBUG, QObject::tr("Native software render %1x%2 completed in %3 ms using %4 threads.")
+                                                        .arg(Width).arg(Height).arg(Timer.elapsed())
+                                                        .arg(QThreadPool::globalInstance()->maxThreadCount()));
+    } else {
+        ImageView->OnDraw();
+    }
+
+    if (Rendered)
+        Image = ImageView->GetRenderImage();
+
+    if (!Software)
+        ImageView->EndRenderToImage();
+#ifdef QT_DEBUG_MODE
+    // Verify the software render against the OpenGL framebuffer render when it is available
+    else if (Rendered && HasOpenGL && Preferences::nativeSoftwareRenderer && Preferences::debugLogging) {
+        ImageView->SetOffscreenContext();
+        ImageView->MakeCurrent();
+        ImageView->SetReuseRenderFramebuffer(true);
+
+        if (ImageView->BeginRenderToImage(Width, Height)) {
+            ImageView->OnDraw();
+            const QImage ReferenceImage = ImageView->GetRenderImage();
+            ImageView->EndRenderToImage();
+            emit gui->messageSig(LOG_DEBUG, nativeSoftwareRenderDifference(Image, ReferenceImage));
+        }
+    }
+#endif
+
+    Model->SetTemporaryStep(CurrentStep);
+
+    if (!Model->IsActive())
+        Model->CalculateStep(LC_STEP_MAX);
+
+    return Rendered;
+}
+
+void NativeRenderSession::reset()
+{
+    mContent.clear();
+    mSettingsKey.clear();
+    mProjectSerial = 0;
+}
+
+QString const NativeRenderSession::statistics() const
+{
+    const int loads = mFullLoads + mDeltaLoads + mReuses;
+    const double hitRatio = loads ? 100.0 * (mDeltaLoads + mReuses) / loads : 0.0;
+
+    return QObject::tr("Native render session: %1 full loads, %2 delta loads, %3 reused - %4% hit ratio")
+                       .arg(mFullLoads).arg(mDeltaLoads).arg(mReuses)
+                       .arg(hitRatio, 0, 'f', 1);
+}
+
 bool Render::LoadViewer(const NativeOptions *Options) {
 
     if (!lpub->currentStep)
@@ -40,6 +40,9 @@ class RotStepMeta;
 class FloatPairMeta;
 class NativeOptions;
 class Project;
+class lcModel;
+class lcCamera;
+class QImage;
 class StudStyleMeta;
 class AutoEdgeColorMeta;
 class HighContrastColorMeta;
@@ -188,6 +191,52 @@ public:
   virtual float cameraDistance(Meta &meta, float);
 };
 
+/****************************************************************************
+ *
+ * The native render session keeps the render image project loaded by the
+ * last Native CSI/PLI render resident. A subsequent render of identical
+ * content reuses the loaded model, a render whose content only appends part
+ * lines to the previous single model content is applied as a delta and
+ * anything else falls back to a full project load. Content is compared
+ * without its LDraw file header and NOFILE line. Images are rendered into
+ * a framebuffer that is reused across renders on the offscreen context.
+ *
+ ***************************************************************************/
+
+class NativeRenderSession
+{
+public:
+  NativeRenderSession()
+    : mProjectSerial(0),
+      mFullLoads(0),
+      mDeltaLoads(0),
+      mReuses(0)
+  { }
+  bool            LoadProject(const NativeOptions *);
+  bool            RenderImage(lcModel *,
+                              lcCamera *,
+                              const QString &cameraName,
+                              bool isOrtho,
+                              int width,
+                              int height,
+                              QImage &image);
+  void            reset();
+  QString const   statistics() const;
+
+private:
+  static QString const settingsKey(const NativeOptions *);
+  static QByteArray const contentBody(const QByteArray &);
+  bool            fullLoad(const NativeOptions *);
+  bool            applyDelta(const QByteArray &);
+
+  QByteArray      mContent;
+  QString         mSettingsKey;
+  quint64         mProjectSerial;
+  int             mFullLoads;
+  int             mDeltaLoads;
+  int             mReuses;
+};
+
 inline void removeEmptyStrings(QStringList &l)
 {
   l.removeAll({});
@@ -198,5 +247,6 @@ extern LDGLite ldglite;
 extern LDView  ldview;
 extern POVRay  povray;
 extern Native  native;
+extern NativeRenderSession nativeSession;
 
 #endif
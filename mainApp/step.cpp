@@ -44,6 +44,7 @@
 #include "paths.h"
 #include "ldrawfiles.h"
 #include "lc_application.h"
+#include "imagecache.h"
 #include <LDVQt/LDVImageMatte.h>
 
 /*********************************************************************
@@ -794,7 +795,7 @@ int Step::createCsi(
 
   // If not using LDView SCall, populate pixmap
   if (! Render::useLDViewSCall()) {
-      pixmap->load(pngName);
+      ImageCache::loadPixmap(pngName, pixmap);
       csiPlacement.size[0] = pixmap->width();
       csiPlacement.size[1] = pixmap->height();
       viewerOptions->ImageWidth  = pixmap->width();
@@ -28,7 +28,7 @@
 
 bool            StickerParts::result;
 QString         StickerParts::empty;
-QList<QString>  StickerParts::stickerParts;
+QSet<QString>   StickerParts::stickerParts;
 
 StickerParts::StickerParts()
 {
@@ -69,7 +69,7 @@ StickerParts::StickerParts()
                 QString sLine = in.readLine(0);
                 if (sLine.contains(rx)) {
                     QString stickerPartID = rx.cap(1);
-                    stickerParts.append(stickerPartID.toLower().trimmed());
+                    stickerParts.insert(stickerPartID.toLower().trimmed());
                     //logDebug() << "** StickerPartID: " << stickerPartID.toLower();
                 }
             }
@@ -85,7 +85,7 @@ StickerParts::StickerParts()
                     continue;
                 if (sLine.contains(rx)) {
                     QString stickerPartID = rx.cap(1);
-                    stickerParts.append(stickerPartID.toLower().trimmed());
+                    stickerParts.insert(stickerPartID.toLower().trimmed());
                 }
             }
         }
@@ -105,12 +105,21 @@ const bool &StickerParts::hasStickerPart(QString part)
 
 const bool &StickerParts::lineHasStickerPart(const QString &line)
 {
-    QString part;
-    QStringList tt = line.split(" ", SkipEmptyParts);
-    for (int t = 14; t < tt.size(); t++) // treat spaces
-        part += (tt[t]+" ");
+    // find the start of the part token in one pass, treat spaces
+    int tokens = 0, partStart = -1;
+    for (int i = 0; i < line.size() && partStart < 0; i++) {
+        if (line.at(i) != QLatin1Char(' ') && (i == 0 || line.at(i - 1) == QLatin1Char(' '))) {
+            if (tokens == 14)
+                partStart = i;
+            tokens++;
+        }
+    }
+    if (partStart < 0) {
+        result = false;
+        return result;
+    }
 
-    return hasStickerPart(part);
+    return hasStickerPart(line.mid(partStart).split(QLatin1Char(' '), SkipEmptyParts).join(QLatin1Char(' ')));
 }
 
 void StickerParts::loadStickerParts(QByteArray &Buffer)
@@ -17,13 +17,14 @@
 
 #include <QString>
 #include <QStringList>
+#include <QSet>
 
 class StickerParts
 {
   private:
     static bool                     result;
     static QString                  empty;
-    static QList<QString>           stickerParts;
+    static QSet<QString>            stickerParts;
   public:
     StickerParts();
     static void loadStickerParts(QByteArray &Buffer);
@@ -45,6 +45,7 @@
 
 #include "lc_viewwidget.h"
 #include "lc_previewwidget.h"
+#include "imagecache.h"
 
 const Where &SubModel::topOfStep()
 {
@@ -551,7 +552,7 @@ int SubModel::createSubModelImage(
       viewerOptions->ImageWidth  = 1600;
       viewerOptions->ImageHeight = 1600;
   } else {
-      pixmap->load(imageName);
+      ImageCache::loadPixmap(imageName, pixmap);
       viewerOptions->ImageWidth  = pixmap->width();
       viewerOptions->ImageHeight = pixmap->height();
   }
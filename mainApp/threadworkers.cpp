@@ -14,6 +14,7 @@
 
 #include <QFileInfo>
 #include <QString>
+#include <QSet>
 #include <quazip.h>
 #include <quazipfile.h>
 
@@ -26,6 +27,7 @@
 #include "application.h"
 #include "editwindow.h"
 #include "lpub_preferences.h"
+#include "partpathindex.h"
 #if (QT_VERSION >= QT_VERSION_CHECK(5, 0, 0))
 #include <QtConcurrent>
 #endif
@@ -38,6 +40,11 @@ PartWorker::PartWorker(QString archiveFile, QObject *parent) : QObject(parent)
 {
   _ldrawArchiveFile       = archiveFile;
   _endThreadNowRequested  = false;
+
+  connect(&archiveParts, SIGNAL(progressRangeSig(const int &, const int &)),
+          this,          SIGNAL(progressRangeSig(const int &, const int &)));
+  connect(&archiveParts, SIGNAL(progressSetValueSig(const int &)),
+          this,          SIGNAL(progressSetValueSig(const int &)));
 }
 
 PartWorker::PartWorker(bool onDemand, QObject *parent) : QObject(parent)
@@ -46,6 +53,11 @@ PartWorker::PartWorker(bool onDemand, QObject *parent) : QObject(parent)
   _endThreadNowRequested  = false;
   _ldrawCustomArchive     = Preferences::validLDrawCustomArchive;
 
+  connect(&archiveParts, SIGNAL(progressRangeSig(const int &, const int &)),
+          this,          SIGNAL(progressRangeSig(const int &, const int &)));
+  connect(&archiveParts, SIGNAL(progressSetValueSig(const int &)),
+          this,          SIGNAL(progressSetValueSig(const int &)));
+
   if (! onDemand) {
     _ldSearchDirsKey = Preferences::ldrawSearchDirsKey;
     _customPartDir   = QDir::toNativeSeparators(QString("%1/%2custom/parts").arg(Preferences::lpubDataPath).arg(Preferences::validLDrawLibrary));
@@ -145,7 +157,7 @@ void PartWorker::ldsearchDirPreferences() {
       bool customDirsIncluded = false;
       // Process directories...
       for (QString const &searchDir : searchDirs) {
-          if (QDir(searchDir).entryInfoList(QDir::Dirs|QDir::Files|QDir::NoSymLinks).count() > 0) {
+          if (PartPathIndex::hasEntries(searchDir, QDir::Dirs|QDir::Files|QDir::NoSymLinks)) {
               // Skip fade/highlight custom directory if not doFadeStep or not doHighlightStep
               QString const customDir = QDir::toNativeSeparators(searchDir.toLower());
               if ((!doFadeStep() && !doHighlightStep()) && (customDir == _customPartDir.toLower() || customDir == _customPrimDir.toLower()))
@@ -175,14 +187,14 @@ void PartWorker::ldsearchDirPreferences() {
               emit gui->messageSig(LOG_INFO, tr("Add custom primitive directory %1").arg(_customPrimDir));
               customDirsIncluded = true;
           } else {
-              if (QDir(_customPartDir).entryInfoList(QDir::Files|QDir::NoSymLinks).count() > 0) {
+              if (PartPathIndex::hasEntries(_customPartDir, QDir::Files|QDir::NoSymLinks)) {
                 Preferences::ldSearchDirs << _customPartDir;
                 customDirsIncluded = true;
                 emit gui->messageSig(LOG_INFO, tr("Add custom part directory: %1").arg(_customPartDir));
               } else {
                 emit gui->messageSig(LOG_INFO, tr("Custom part directory is empty and will be ignored: %1").arg(_customPartDir));
               }
-              if (QDir(_customPrimDir).entryInfoList(QDir::Files|QDir::NoSymLinks).count() > 0) {
+              if (PartPathIndex::hasEntries(_customPrimDir, QDir::Files|QDir::NoSymLinks)) {
                 Preferences::ldSearchDirs << _customPrimDir;
                 customDirsIncluded = true;
                 emit gui->messageSig(LOG_INFO, tr("Add custom primitive directory: %1").arg(_customPrimDir));
@@ -234,6 +246,9 @@ void PartWorker::ldsearchDirPreferences() {
         if (!Preferences::ldSearchDirs.contains(_ldrawModelsDir,Qt::CaseInsensitive))
             Preferences::ldSearchDirs << _ldrawModelsDir;
 
+    // list the search directories in parallel, only changed directories are listed again
+    PartPathIndex::update(Preferences::ldSearchDirs);
+
     updateLDSearchDirs();
 }
 
@@ -281,7 +296,7 @@ bool PartWorker::loadLDrawSearchDirs() {
             }
           if (! excludeSearchDir) {
               // check if empty
-              if (QDir(ldrawSearchDir).entryInfoList(QDir::Files|QDir::Dirs|QDir::NoSymLinks).count() > 0) {
+              if (PartPathIndex::hasEntries(ldrawSearchDir, QDir::Files|QDir::Dirs|QDir::NoSymLinks)) {
                   Preferences::ldSearchDirs << ldrawSearchDir;
                   emit gui->messageSig(LOG_INFO, tr("Added search directory: %1").arg(ldrawSearchDir));
                 }
@@ -294,13 +309,13 @@ bool PartWorker::loadLDrawSearchDirs() {
         }
       // If fade step enabled but custom directories not defined in ldSearchDirs, add custom directories
       if ((doFadeStep() || doHighlightStep()) && !customDirsIncluded) {
-          if (QDir(_customPartDir).entryInfoList(QDir::Files|QDir::NoSymLinks).count() > 0) {
+          if (PartPathIndex::hasEntries(_customPartDir, QDir::Files|QDir::NoSymLinks)) {
               Preferences::ldSearchDirs << _customPartDir;
               emit gui->messageSig(LOG_INFO, tr("Add custom part directory: %1").arg(_customPartDir));
             } else {
               emit gui->messageSig(LOG_INFO, tr("Custom part directory is empty and will be ignored: %1").arg(_customPartDir));
             }
-          if (QDir(_customPrimDir).entryInfoList(QDir::Files|QDir::NoSymLinks).count() > 0) {
+          if (PartPathIndex::hasEntries(_customPrimDir, QDir::Files|QDir::NoSymLinks)) {
               Preferences::ldSearchDirs << _customPrimDir;
               emit gui->messageSig(LOG_INFO, tr("Add custom primitive directory: %1").arg(_customPrimDir));
             } else {
@@ -331,13 +346,13 @@ bool PartWorker::loadLDrawSearchDirs() {
                   if (!excludeSearchDir) {
                       // First, check if there are files in the subDir
                       bool dirIsEmpty = true;
-                      if (QDir(unofficialSubDir).entryInfoList(QDir::Files|QDir::NoSymLinks).count() > 0) {
+                      if (PartPathIndex::hasEntries(unofficialSubDir, QDir::Files|QDir::NoSymLinks)) {
                           Preferences::ldSearchDirs << unofficialSubDir;
                           dirIsEmpty = false;
                           emit gui->messageSig(LOG_INFO, tr("Added search directory: %1").arg(unofficialSubDir));
                       }
                       // Second, check if there are subSubDirs in subDir - e.g. ...unofficial/custom/textures
-                      if (QDir(unofficialSubDir).entryInfoList(QDir::Dirs|QDir::NoSymLinks).count() > 0) {
+                      if (PartPathIndex::hasEntries(unofficialSubDir, QDir::Dirs|QDir::NoSymLinks)) {
                           // 1. get the unofficial subDir path - e.g. .../unofficial/custom/
                           QDir subSubDir(unofficialSubDir);
                           // 2. get list of subSubDirs in subDir path - e.g. .../custom/parts, .../custom/textures
@@ -347,13 +362,13 @@ bool PartWorker::loadLDrawSearchDirs() {
                               // 4. get the unofficialSubSubDir path - e.g. .../unofficial/custom/textures
                               QString const unofficialSubSubDir = QDir::toNativeSeparators(QString("%1/%2").arg(unofficialSubDir).arg(subSubDirName));
                               // First, check if there are files in subSubSubDir
-                              if (QDir(unofficialSubSubDir).entryInfoList(QDir::Files|QDir::NoSymLinks).count() > 0) {
+                              if (PartPathIndex::hasEntries(unofficialSubSubDir, QDir::Files|QDir::NoSymLinks)) {
                                   Preferences::ldSearchDirs << unofficialSubSubDir;
                                   dirIsEmpty = false;
                                   emit gui->messageSig(LOG_INFO, tr("Added search directory: %1").arg(unofficialSubSubDir));
                               }
                               // Second, check if there are subSubSubDirs in subDir - e.g. ...unofficial/custom/textures/model
-                              if (QDir(unofficialSubSubDir).entryInfoList(QDir::Dirs|QDir::NoSymLinks).count() > 0) {
+                              if (PartPathIndex::hasEntries(unofficialSubSubDir, QDir::Dirs|QDir::NoSymLinks)) {
                                   // 5. get the unofficial subDir path - e.g. .../unofficial/custom/
                                   QDir subSubSubDir(unofficialSubSubDir);
                                   // 6. get list of subSubSubDirs in subDir path - e.g. .../custom/textures/model1, .../custom/textures/model2
@@ -377,7 +392,7 @@ bool PartWorker::loadLDrawSearchDirs() {
                                       // If subSubSubDir is not excluded - e.g. ...unofficial/custom/textures/parts/s...
                                       if (!excludeSearchDir) {
                                           // 9. Check if there are files in subDir
-                                          if (QDir(unofficialSubSubSubDir).entryInfoList(QDir::Files|QDir::NoSymLinks).count() > 0) {
+                                          if (PartPathIndex::hasEntries(unofficialSubSubSubDir, QDir::Files|QDir::NoSymLinks)) {
                                               Preferences::ldSearchDirs << unofficialSubSubSubDir;
                                               dirIsEmpty = false;
                                               emit gui->messageSig(LOG_INFO, tr("Added search directory: %1").arg(unofficialSubSubSubDir));
@@ -454,7 +469,7 @@ void PartWorker::populateLdgLiteSearchDirs() {
             }
             if (!excludeSearchDir) {
                 // check if empty
-                if (QDir(ldgliteSearchDir).entryInfoList(QDir::Files|QDir::NoSymLinks).count() > 0) {
+                if (PartPathIndex::hasEntries(ldgliteSearchDir, QDir::Files|QDir::NoSymLinks)) {
                     count++;
                     count > 1 ? Preferences::ldgliteSearchDirs.append(QString("|%1").arg(ldgliteSearchDir)):
                                 Preferences::ldgliteSearchDirs.append(ldgliteSearchDir);
@@ -632,8 +647,12 @@ void PartWorker::processCustomColourParts(PartType partType, bool overwrite, boo
 
   QStringList customPartsDirs;
   QStringList colourPartList;
+  QSet<QString> submittedParts;
   int existingCustomParts = 0;
 
+  // the archives change when the new parts are archived so list them again for each run
+  _archivePartEntries.clear();
+
   //DISABLE PROGRESS BAR - CAUSING MESSAGEBAR OVERLOAD
   //emit progressBarInitSig();
   //emit progressMessageSig("Parse Model File");
@@ -660,6 +679,10 @@ void PartWorker::processCustomColourParts(PartType partType, bool overwrite, boo
               QString fileString = LDrawColourParts::getLDrawColourPartInfo(tokens[tokens.size()-1]);
               // validate part is static color part;
               if (!fileString.isEmpty()) {
+                  // each colour part is checked once, not once per model line
+                  if (submittedParts.contains(fileString))
+                      continue;
+                  submittedParts.insert(fileString);
                   QString fileDir;
                   QString libType  = fileString.section(":::",0,0);
                   QString fileName = fileString.section(":::",1,1);
@@ -886,20 +909,22 @@ bool PartWorker::processColourParts(const QStringList &colourPartList, const Par
 
         //emit progressSetValueSig(partCount++);
 
-        QuaZip zip(unOffLib ? unofficialLib : officialLib);
+        QString const archiveFile = unOffLib ? unofficialLib : officialLib;
+        QuaZip zip(archiveFile);
         if (!zip.open(QuaZip::mdUnzip)) {
             emit gui->messageSig(LOG_ERROR, tr("Could not open archive to add content. Return code %1.<br>"
                                                "Archive file %2 may be open in another program.")
-                                               .arg(zip.getZipError()).arg(QFileInfo(unOffLib ? unofficialLib : officialLib).fileName()));
+                                               .arg(zip.getZipError()).arg(QFileInfo(archiveFile).fileName()));
             return false;
         }
 
-        for(bool f=zip.goToFirstFile(); f&&endThreadNotRequested(); f=zip.goToNextFile()) {
+        QString const entryName = archivePartEntry(zip, archiveFile, libPartName);
+        if (!entryName.isEmpty() && endThreadNotRequested()) {
 
-            QFileInfo libPartFile(zip.getCurrentFileName());
-            if (libPartFile.fileName().toLower() == libPartName && ! partAlreadyInList(libPartName)) {
+            partFound = true;
+            if (! partAlreadyInList(libPartName)) {
 
-                partFound = true;
+                zip.setCurrentFile(entryName);
                 QByteArray qba;
                 QuaZipFile zipFile(&zip);
                 if (zipFile.open(QIODevice::ReadOnly)) {
@@ -946,18 +971,12 @@ bool PartWorker::processColourParts(const QStringList &colourPartList, const Par
                             } else {
                                 customFileDirPath.setPath(QDir::toNativeSeparators(QString("%1/%2").arg(Preferences::lpubDataPath).arg(Paths::customPartDir)));
                             }
-                            bool entryExists = false;
-                            QString customFileName = fileName.replace(".dat", "-" + nameMod + ".dat");
-                            QFileInfo customFileInfo(customFileDirPath,customFileName);
-                            entryExists = customFileInfo.exists();
-                            // check if child part entry already in list
+                            // check if child part entry already in list before looking for the file
+                            bool entryExists = childrenColourParts.contains(childFileString);
                             if (!entryExists) {
-                                for (QString const &childColourPart : childrenColourParts) {
-                                    if (childColourPart == childFileString) {
-                                        entryExists = true;
-                                        break;
-                                    }
-                                }
+                                QString customFileName = fileName.replace(".dat", "-" + nameMod + ".dat");
+                                QFileInfo customFileInfo(customFileDirPath,customFileName);
+                                entryExists = customFileInfo.exists();
                             }
                             // add chile part entry to list
                             if (!entryExists) {
@@ -988,12 +1007,9 @@ bool PartWorker::processColourParts(const QStringList &colourPartList, const Par
                 insert(_partFileContents, libPartName, ldrawPartType, true);
                 _partFileContents.clear();
                 partsProcessed++;
-                break;
 
-            } else if (libPartFile.fileName().toLower() == libPartName && partAlreadyInList(libPartName)) {
-                partFound = true;
+            } else {
                 emit gui->messageSig(LOG_TRACE, tr("Part already in list: %1").arg(libPartName));
-                break;
             }
         }
 
@@ -1027,6 +1043,29 @@ bool PartWorker::processColourParts(const QStringList &colourPartList, const Par
     return true;
 }
 
+/*
+ * Return the entry name of the first file named partName in archiveFile.
+ * The entry names of each archive are listed once per run, so a colour
+ * part no longer costs a scan of every archive entry.
+ */
+QString PartWorker::archivePartEntry(QuaZip &zip, const QString &archiveFile, const QString &partName)
+{
+    QHash<QString, QHash<QString, QString> >::iterator i = _archivePartEntries.find(archiveFile);
+    if (i == _archivePartEntries.end()) {
+        QHash<QString, QString> entries;
+        QStringList const entryNames = zip.getFileNameList();
+        entries.reserve(entryNames.size());
+        for (QString const &entryName : entryNames) {
+            QString const fileName = entryName.mid(entryName.lastIndexOf('/') + 1).toLower();
+            if (!entries.contains(fileName))
+                entries.insert(fileName, entryName);
+        }
+        i = _archivePartEntries.insert(archiveFile, entries);
+    }
+
+    return i.value().value(partName);
+}
+
 
 bool PartWorker::createCustomPartFiles(const PartType partType, bool  overwriteCustomParts) {
 
@@ -1361,6 +1400,9 @@ bool PartWorker::processPartsArchive(const QStringList &ldPartsDirs, const QStri
 
   tf.start();
 
+  // per part progress when archiving a single directory, otherwise per directory
+  archiveParts.setReportProgress(searchDirs == 1 && okToEmitToProgressBar());
+
   for (int i = 0; i < searchDirs && endThreadNotRequested(); i++) {
       t.start();
 
@@ -3130,7 +3172,6 @@ int LoadModelWorker::loadModel(LDrawFile *ldrawFile, const QString &filePath)
         } else if (ldrawFile) {
             fileName = QFileInfo(filePath).fileName();
             contentList = ldrawFile->contents(fileName);
-            content = contentList.join("\n");
         } else {
             emit gui->messageSig(LOG_ERROR, tr("No suitable data source detected for %1").arg(fileName));
             return 1;
@@ -3159,6 +3200,9 @@ int LoadModelWorker::loadModel(LDrawFile *ldrawFile, const QString &filePath)
         if (contentList.size())
             setPagedContent(contentList);
     } else {
+        // the joined text is only built when the content is not paged
+        if (content.isEmpty())
+            content = contentList.join("\n");
         if (!content.isEmpty())
             setPlainText(content);
     }
@@ -204,6 +204,11 @@ private:
        const QStringList      &colourPartList,
        const PartType         partType);
 
+   QString archivePartEntry(
+       QuaZip                &zip,
+       const QString         &archiveFile,
+       const QString         &partName);
+
    bool processPartsArchive(
        const QStringList     &ldPartsDirs,
        const QString         &comment = QString(),
@@ -219,6 +224,7 @@ private:
 
    bool                      _endThreadNowRequested;
    QMap<QString, ColourPart> _colourParts;
+   QHash<QString, QHash<QString, QString> > _archivePartEntries; // archive, lower case file name, entry name
    QStringList               _emptyList;
    QString                   _emptyString;
    QStringList               _ldrawStaticColourParts;
@@ -103,12 +103,8 @@ void Gui::contentsChange(
 
   /* Calculate the characters removed from the LDrawFile */
 
-  if (_charsRemoved && lpub->ldrawFile.contains(fileName)) {
-
-    QString contents = lpub->ldrawFile.contents(fileName).join("\n");
-
-    charsRemoved = contents.mid(position,_charsRemoved);
-  }
+  if (_charsRemoved && lpub->ldrawFile.contains(fileName))
+    charsRemoved = lpub->ldrawFile.contentsRange(fileName,position,_charsRemoved);
   
   undoStack->push(new ContentsChangeCommand(&lpub->ldrawFile,
                                             fileName,
@@ -223,7 +219,13 @@ void Gui::cleanChanged(bool cleanState)
 void Gui::scanPast(Where &topOfStep, const QRegExp &lineRx)
 {
   const bool isScanPastGlobal = lineRx.pattern() == QStringLiteral(GLOBAL_META_RX);
-  const bool onStepMeta = lpub->ldrawFile.readLine(topOfStep.modelName,topOfStep.lineNumber) == QStringLiteral("0 STEP");
+  // read the lines from one shared copy instead of a file lookup per line
+  const QStringList contents = lpub->ldrawFile.contents(topOfStep.modelName);
+  auto readLine = [&contents] (int lineNumber)
+  {
+    return lineNumber >= 0 && lineNumber < contents.size() ? contents.at(lineNumber) : QString();
+  };
+  const bool onStepMeta = readLine(topOfStep.lineNumber) == QStringLiteral("0 STEP");
   QRegExp endRx("^[1-5] |^0 ROTATION|^0 STEP$|^0 ROTSTEP");
   if (isScanPastGlobal) {
     if (onStepMeta)
@@ -233,23 +235,23 @@ void Gui::scanPast(Where &topOfStep, const QRegExp &lineRx)
   }
   Where walk    = onStepMeta ? topOfStep + 1 : topOfStep;
   Where lastPos = topOfStep;
-  int  numLines = lpub->ldrawFile.size(walk.modelName);
+  int  numLines = contents.size();
   bool foundHeaderLine = false;
   bool isHeaderLine = false;
   auto isDescriptionLine = [&]()
   {
     if (!isScanPastGlobal || foundHeaderLine)
       return false;
-    QString nextLine = lpub->ldrawFile.readLine(walk.modelName,walk.lineNumber+1);
+    QString nextLine = readLine(walk.lineNumber+1);
     foundHeaderLine = isHeader(nextLine);
     return foundHeaderLine;
   };
   if (walk < numLines) {
-    QString line = lpub->ldrawFile.readLine(walk.modelName,walk.lineNumber);
+    QString line = readLine(walk.lineNumber);
     if (isScanPastGlobal && line.contains(endRx))
       return;
     for ( ++walk; walk < numLines; ++walk) {
-      line = lpub->ldrawFile.readLine(walk.modelName,walk.lineNumber);
+      line = readLine(walk.lineNumber);
       if (isScanPastGlobal) {
           isHeaderLine = isHeader(line);
           if (isHeaderLine)
@@ -290,10 +292,11 @@ bool Gui::stepContains(Where &topOfStep, QRegExp &lineRx, bool displayModel)
   bool found = false;
   Where walk = topOfStep;
   LDrawFile &ldrawFile = lpub->ldrawFile;
-  int  numLines = ldrawFile.size(walk.modelName);
-  QRegExp endRx("^0\\s+STEP$|^0\\s+ROTSTEP|^0\\s+!DATA");
+  // scan only to the indexed line that ends the step (0 STEP, 0 ROTSTEP or 0 !DATA)
+  const QStringList contents = ldrawFile.contents(walk.modelName);
+  const int numLines = qMin(ldrawFile.stepBoundary(walk.modelName, walk.lineNumber) + 1, contents.size());
   for (; walk < numLines; ++walk) {
-    QString line = ldrawFile.readLine(walk.modelName,walk.lineNumber);
+    const QString &line = contents.at(walk.lineNumber);
     if (displayModel) {
       if (line.contains(lineRx)) {
         // Can consolidate multiple illegal displayModel commands in a single Rx
@@ -304,7 +307,7 @@ bool Gui::stepContains(Where &topOfStep, QRegExp &lineRx, bool displayModel)
     } else if ((found = line.contains(lineRx))) {
       topOfStep = walk;
     }
-    if (found || line.contains(endRx)) {
+    if (found) {
       break;
     }
   }
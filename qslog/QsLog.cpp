@@ -26,10 +26,6 @@
 
 #include "QsLog.h"
 #include "QsLogDest.h"
-#ifdef QS_LOG_SEPARATE_THREAD
-#include <QThreadPool>
-#include <QRunnable>
-#endif
 #include <QMutex>
 #include <QVector>
 #include <QDateTime>
@@ -37,8 +33,14 @@
 #include <QtGlobal>
 #include <cassert>
 #include <cstdlib>
+#include <cstring>
 #include <stdexcept>
-#include <QFileInfo>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 namespace QsLogging
 {
@@ -113,27 +115,100 @@ namespace QsLogging
       }
   }
 
-#ifdef QS_LOG_SEPARATE_THREAD
-  class LogWriterRunnable : public QRunnable
+  // returns the file name part of a __FILE__ path without allocating
+  static const char* FileNameFromPath(const char* path)
+  {
+    const char* fileName = path;
+    for (const char* c = path; *c; ++c)
+      if (*c == '/' || *c == '\\')
+        fileName = c + 1;
+    return fileName;
+  }
+
+  struct LogEntry
+  {
+    std::atomic<LogEntry*> next;
+    QString colourMessage;
+    QString plainMessage;
+    Level level;
+  };
+
+  // Intrusive multi-producer, single-consumer queue. Producers push with a
+  // single atomic exchange and never block; only the writer thread pops.
+  class LogQueue
   {
   public:
-    LogWriterRunnable(QString message, Level level);
-    virtual void run();
+    LogQueue()
+      : head(&stub)
+      , tail(&stub)
+    {
+      stub.next.store(nullptr);
+    }
+
+    void push(LogEntry* entry)
+    {
+      entry->next.store(nullptr, std::memory_order_relaxed);
+      LogEntry* previous = head.exchange(entry, std::memory_order_acq_rel);
+      previous->next.store(entry, std::memory_order_release);
+    }
+
+    // returns nullptr when empty, or when a producer is half way through a push
+    LogEntry* pop()
+    {
+      LogEntry* first = tail;
+      LogEntry* next = first->next.load(std::memory_order_acquire);
+      if (first == &stub) {
+        if (!next)
+          return nullptr;
+        tail = first = next;
+        next = next->next.load(std::memory_order_acquire);
+      }
+      if (next) {
+        tail = next;
+        return first;
+      }
+      if (first != head.load(std::memory_order_acquire))
+        return nullptr;
+      push(&stub);
+      next = first->next.load(std::memory_order_acquire);
+      if (next) {
+        tail = next;
+        return first;
+      }
+      return nullptr;
+    }
 
   private:
-    QString mMessage;
-    Level mLevel;
+    std::atomic<LogEntry*> head;
+    LogEntry* tail;
+    LogEntry stub;
   };
-#endif
 
   class LoggerImpl
   {
   public:
     LoggerImpl();
 
-#ifdef QS_LOG_SEPARATE_THREAD
-    QThreadPool threadPool;
-#endif
+    void startWriter();
+    void stopWriter();
+    void runWriter();
+    void wakeWriter();
+
+    // background writer
+    LogQueue queue;
+    std::thread writer;
+    std::mutex writerMutex;
+    std::condition_variable writerCondition;
+    std::condition_variable flushCondition;
+    std::atomic<bool> writerIdle;
+    std::atomic<quint64> enqueuedCount;
+    quint64 writtenCount;
+    quint64 batchCount;
+    qint64 writeNanoseconds;
+    std::atomic<bool> writerRunning;
+    bool writerStopping;
+    std::atomic<bool> asynchronousWrite;
+
     QMutex logMutex;
     Level level;
     DestinationList destList;
@@ -159,23 +234,20 @@ namespace QsLogging
     bool fatalLevel;
   };
 
+  LoggerImpl::LoggerImpl()
+    : writerIdle(false)
+    , enqueuedCount(0)
+    , writtenCount(0)
+    , batchCount(0)
+    , writeNanoseconds(0)
+    , writerRunning(false)
+    , writerStopping(false)
 #ifdef QS_LOG_SEPARATE_THREAD
-  LogWriterRunnable::LogWriterRunnable(QString message, Level level)
-    : QRunnable()
-    , mMessage(message)
-    , mLevel(level)
-  {
-  }
-
-  void LogWriterRunnable::run()
-  {
-    Logger::instance().write(mMessage, mLevel);
-  }
+    , asynchronousWrite(true)
+#else
+    , asynchronousWrite(false)
 #endif
-
-
-  LoggerImpl::LoggerImpl()
-    : level(InfoLevel)
+    , level(InfoLevel)
     , includeLogLevel(      true)
     , includeTimeStamp(     true)
     , includeLineNumber(    true)
@@ -197,10 +269,93 @@ namespace QsLogging
   {
     // assume at least file + console
     destList.reserve(2);
-#ifdef QS_LOG_SEPARATE_THREAD
-    threadPool.setMaxThreadCount(1);
-    threadPool.setExpiryTimeout(-1);
-#endif
+  }
+
+  void LoggerImpl::startWriter()
+  {
+    if (writerRunning.load(std::memory_order_acquire))
+      return;
+    std::lock_guard<std::mutex> lock(writerMutex);
+    if (writerRunning)
+      return;
+    writerStopping = false;
+    writerRunning  = true;
+    writer = std::thread(&LoggerImpl::runWriter, this);
+  }
+
+  void LoggerImpl::stopWriter()
+  {
+    {
+      std::lock_guard<std::mutex> lock(writerMutex);
+      if (!writerRunning)
+        return;
+      writerStopping = true;
+    }
+    writerCondition.notify_one();
+    writer.join();
+    std::lock_guard<std::mutex> lock(writerMutex);
+    writerRunning = false;
+  }
+
+  void LoggerImpl::wakeWriter()
+  {
+    if (writerIdle.load()) {
+      std::lock_guard<std::mutex> lock(writerMutex);
+      writerCondition.notify_one();
+    }
+  }
+
+  //! drains the queue in batches - destinations are locked and flushed once per batch
+  void LoggerImpl::runWriter()
+  {
+    static const size_t MaxBatchSize = 256;
+    std::vector<LogEntry*> batch;
+    batch.reserve(MaxBatchSize);
+
+    for (;;) {
+      while (batch.size() < MaxBatchSize) {
+        LogEntry* entry = queue.pop();
+        if (!entry)
+          break;
+        batch.push_back(entry);
+      }
+
+      if (!batch.empty()) {
+        const auto start = std::chrono::steady_clock::now();
+        {
+          QMutexLocker lock(&logMutex);
+          for (LogEntry* entry : batch)
+            for (DestinationList::iterator it = destList.begin(), endIt = destList.end(); it != endIt; ++it)
+              if ((*it)->type() != QLatin1String("file") && entry->level != StatusLevel)
+                (*it)->write(entry->colourMessage, entry->level);
+              else if ((*it)->type() == QLatin1String("file"))
+                (*it)->write(entry->plainMessage, entry->level);
+          for (DestinationList::iterator it = destList.begin(), endIt = destList.end(); it != endIt; ++it)
+            (*it)->flush();
+        }
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+
+        std::lock_guard<std::mutex> lock(writerMutex);
+        writtenCount += batch.size();
+        batchCount++;
+        writeNanoseconds += std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+        for (LogEntry* entry : batch)
+          delete entry;
+        batch.clear();
+        flushCondition.notify_all();
+        continue;
+      }
+
+      std::unique_lock<std::mutex> lock(writerMutex);
+      if (writerStopping && enqueuedCount.load() == writtenCount)
+        break;
+      writerIdle.store(true);
+      // a producer that missed the idle flag has already counted its message
+      writerCondition.wait_for(lock, std::chrono::milliseconds(100), [this] {
+        return writerStopping || enqueuedCount.load() != writtenCount;
+      });
+      writerIdle.store(false);
+    }
   }
 
   Logger::Logger()
@@ -245,9 +400,7 @@ namespace QsLogging
 
   Logger::~Logger()
   {
-#ifdef QS_LOG_SEPARATE_THREAD
-    d->threadPool.waitForDone();
-#endif
+    d->stopWriter();
     delete d;
     d = 0;
   }
@@ -457,31 +610,57 @@ namespace QsLogging
     d->fatalLevel = l;
   }
 
+  //! producers read the flag without the log mutex, so it is atomic and
+  //! cleared before the writer drains the queue and stops
+  void Logger::setAsynchronousWrite(bool e)
+  {
+    d->asynchronousWrite.store(e);
+    if (!e)
+      d->stopWriter();
+  }
+
+  bool Logger::asynchronousWrite() const
+  {
+    return d->asynchronousWrite.load();
+  }
+
+  //! waits for the writer to catch up with the messages queued so far
+  void Logger::flush()
+  {
+    std::unique_lock<std::mutex> lock(d->writerMutex);
+    if (!d->writerRunning || d->writer.get_id() == std::this_thread::get_id())
+      return;
+    const quint64 target = d->enqueuedCount.load();
+    d->writerCondition.notify_one();
+    d->flushCondition.wait(lock, [this, target] { return d->writtenCount >= target || !d->writerRunning; });
+  }
+
+  QString Logger::writeStatistics() const
+  {
+    std::lock_guard<std::mutex> lock(d->writerMutex);
+    const double milliseconds = d->writeNanoseconds / 1000000.0;
+    const double perSecond = d->writeNanoseconds ? d->writtenCount * 1000000000.0 / d->writeNanoseconds : 0.0;
+    return QString("Log writer: %1 messages in %2 batches, %3 ms writing (%4 messages/sec)")
+                   .arg(d->writtenCount)
+                   .arg(d->batchCount)
+                   .arg(milliseconds, 0, 'f', 1)
+                   .arg(perSecond, 0, 'f', 0);
+  }
+
   //! creates the complete log message and passes it to the logger
   void Logger::Helper::writeToLog()
   {
-    QString split         = QString::fromLatin1(QS_LOG_SPLIT);
-    QString headers       = buffer.section(split,0,0).trimmed();
-    QString fileRelPath   = headers.section('|',0,0).trimmed();
-    QString functionInfo  = headers.section('|',1,1).trimmed();
-    QString lineNumber    = headers.section('|',2,2).trimmed();
-    buffer.remove(QString("%1 %2 ").arg(headers, split));
-    QFileInfo info(fileRelPath);
-    QString fileName      = info.fileName();
+    Logger &logger = Logger::instance();
 
-    const char* const levelName = LevelToText(level);
+    // the source location is passed by the macros, so only the parts in use are converted
+    const QString fileName      = logger.includeFileName() && file ? QString::fromUtf8(FileNameFromPath(file)) : QString();
+    const QString functionInfo  = logger.includeFunctionInfo() && function ? QString::fromUtf8(function) : QString();
+    QString lineNumber          = logger.includeLineNumber() ? QString::number(line) : QString();
 
-//    qDebug() << "\nBuffer:       " << buffer <<
-//                "\nSplit:        " << split <<
-//                "\nHeaders:      " << headers <<
-//                "\nfileName:     " << fileName <<
-//                "\nfunctionInfo: " << functionInfo <<
-//                "\nlineNumber:   " << lineNumber <<
-//                "\nRemove:       " << QString("%1%2 ").arg(headers, split);
+    const char* const levelName = LevelToText(level);
 
     QString completePlainMessage,
         completeColorizedMessage;
-    Logger &logger = Logger::instance();
 
 //      qDebug() << "\nIncludes:    " <<
 //                  "\nLogLevel     " << logger.includeLogLevel()     <<
@@ -540,12 +719,13 @@ namespace QsLogging
       }
 
     if (logger.includeTimestamp()) {
+        const QString timeStamp = QDateTime::currentDateTime().toString(fmtDateTime);
         completeColorizedMessage.
-            append(QDateTime::currentDateTime().toString(fmtDateTime)).
+            append(timeStamp).
             append(' ');
         completePlainMessage.
             prepend(' ').
-            prepend(QDateTime::currentDateTime().toString(fmtDateTime));
+            prepend(timeStamp);
       }
 
     // marshal plain message for the log file - color codes are not human readable friendly.
@@ -568,15 +748,27 @@ namespace QsLogging
     }
   }
 
-  //! directs the message to the task queue or writes it directly
+  //! directs the message to the writer queue or writes it directly
   void Logger::enqueueWrite(const QString& colourMessage, const QString& plainMessage, Level level)
   {
-#ifdef QS_LOG_SEPARATE_THREAD
-    LogWriterRunnable *r = new LogWriterRunnable(message, level);
-    d->threadPool.start(r);
-#else
-    write(colourMessage, plainMessage, level);
-#endif
+    if (!d->asynchronousWrite.load()) {
+      write(colourMessage, plainMessage, level);
+      return;
+    }
+
+    d->startWriter();
+
+    LogEntry* entry = new LogEntry;
+    entry->colourMessage = colourMessage;
+    entry->plainMessage  = plainMessage;
+    entry->level         = level;
+    d->queue.push(entry);
+    d->enqueuedCount.fetch_add(1);
+    d->wakeWriter();
+
+    // make sure errors reach the log before a possible crash
+    if (level >= ErrorLevel)
+      flush();
   }
 
   //! Sends the message to all the destinations. The level for this message is passed in case
@@ -591,6 +783,7 @@ namespace QsLogging
           (*it)->write(colourMessage, level);
         else if ((*it)->type() == "file")
           (*it)->write(plainMessage, level);
+        (*it)->flush();
       }
   }
 
@@ -128,14 +128,25 @@ public:
   void setErrorLevel(bool l);
   //! Set to true to enable Fatal log level
   void setFatalLevel(bool l);
+  //! Set to true to queue messages and write them in batches from a background thread
+  void setAsynchronousWrite(bool e);
+  //! Default value is true when built with QS_LOG_SEPARATE_THREAD, otherwise false.
+  bool asynchronousWrite() const;
+  //! Blocks until all queued messages have been written to the destinations
+  void flush();
+  //! Returns the number of messages written, batches and time spent writing
+  QString writeStatistics() const;
 
   //! The helper forwards the streaming to QDebug and builds the final
   //! log message.
   class QSLOG_SHARED_OBJECT Helper
   {
   public:
-    explicit Helper(Level logLevel) :
+    explicit Helper(Level logLevel, const char* file = nullptr, const char* function = nullptr, int line = 0) :
       level(logLevel),
+      file(file),
+      function(function),
+      line(line),
       qtDebug(&buffer) {}
     ~Helper();
     QDebug& stream(){ return qtDebug; }
@@ -145,6 +156,9 @@ public:
     void writeToLog();
 
     Level level;
+    const char* file;
+    const char* function;
+    int line;
     QString buffer;
     QDebug qtDebug;
   };
@@ -159,7 +173,7 @@ private:
 
   LoggerImpl* d;
 
-  friend class LogWriterRunnable;
+  friend class LoggerImpl;
 };
 
 } // end namespace
@@ -168,36 +182,28 @@ private:
 //! in the log output.
 #define logTrace() \
    if( QsLogging::Logger::instance().loggingLevel(QsLogging::TraceLevel) ) \
-         QsLogging::Logger::Helper(QsLogging::TraceLevel).stream() \
-     << __FILE__ << '|' << Q_FUNC_INFO << '|' << __LINE__ << QS_LOG_SPLIT
+         QsLogging::Logger::Helper(QsLogging::TraceLevel, __FILE__, Q_FUNC_INFO, __LINE__).stream()
 #define logNotice() \
    if( QsLogging::Logger::instance().loggingLevel(QsLogging::NoticeLevel) ) \
-     QsLogging::Logger::Helper(QsLogging::NoticeLevel).stream() \
-     << __FILE__ << '|' << Q_FUNC_INFO << '|' << __LINE__ << QS_LOG_SPLIT
+     QsLogging::Logger::Helper(QsLogging::NoticeLevel, __FILE__, Q_FUNC_INFO, __LINE__).stream()
 #define logDebug() \
    if( QsLogging::Logger::instance().loggingLevel(QsLogging::DebugLevel) ) \
-     QsLogging::Logger::Helper(QsLogging::DebugLevel).stream() \
-     << __FILE__ << '|' << Q_FUNC_INFO << '|' << __LINE__ << QS_LOG_SPLIT
+     QsLogging::Logger::Helper(QsLogging::DebugLevel, __FILE__, Q_FUNC_INFO, __LINE__).stream()
 #define logInfo()  \
    if( QsLogging::Logger::instance().loggingLevel(QsLogging::InfoLevel) ) \
-     QsLogging::Logger::Helper(QsLogging::InfoLevel).stream() \
-     << __FILE__ << '|' << Q_FUNC_INFO << '|' << __LINE__ << QS_LOG_SPLIT
+     QsLogging::Logger::Helper(QsLogging::InfoLevel, __FILE__, Q_FUNC_INFO, __LINE__).stream()
 #define logStatus()  \
    if( QsLogging::Logger::instance().loggingLevel(QsLogging::StatusLevel) ) \
-     QsLogging::Logger::Helper(QsLogging::StatusLevel).stream() \
-     << __FILE__ << '|' << Q_FUNC_INFO << '|' << __LINE__ << QS_LOG_SPLIT
+     QsLogging::Logger::Helper(QsLogging::StatusLevel, __FILE__, Q_FUNC_INFO, __LINE__).stream()
 #define logWarning()  \
    if( QsLogging::Logger::instance().loggingLevel(QsLogging::WarningLevel) ) \
-     QsLogging::Logger::Helper(QsLogging::WarningLevel).stream() \
-     << __FILE__ << '|' << Q_FUNC_INFO << '|' << __LINE__ << QS_LOG_SPLIT
+     QsLogging::Logger::Helper(QsLogging::WarningLevel, __FILE__, Q_FUNC_INFO, __LINE__).stream()
 #define logError() \
    if( QsLogging::Logger::instance().loggingLevel(QsLogging::ErrorLevel) ) \
-     QsLogging::Logger::Helper(QsLogging::ErrorLevel).stream() \
-     << __FILE__ << '|' << Q_FUNC_INFO << '|' << __LINE__ << QS_LOG_SPLIT
+     QsLogging::Logger::Helper(QsLogging::ErrorLevel, __FILE__, Q_FUNC_INFO, __LINE__).stream()
 #define logFatal() \
    if( QsLogging::Logger::instance().loggingLevel(QsLogging::FatalLevel) ) \
-     QsLogging::Logger::Helper(QsLogging::FatalLevel).stream() \
-     << __FILE__ << '|' << Q_FUNC_INFO << '|' << __LINE__ << QS_LOG_SPLIT
+     QsLogging::Logger::Helper(QsLogging::FatalLevel, __FILE__, Q_FUNC_INFO, __LINE__).stream()
 
 /* Backup Copy
 #define logTrace() \
@@ -63,6 +63,12 @@ namespace QsLogging
     //!         of the same type will return the same value.
     //!
     virtual QString type() const = 0;
+    //!
+    //! \brief flush
+    //! Writes out buffered output. Called after each message, or after each
+    //! batch of messages when the logger writes asynchronously.
+    //!
+    virtual void flush() {}
   };
   typedef QSharedPointer<Destination> DestinationPtr;
 
@@ -174,7 +174,11 @@ void QsLogging::FileDestination::write(const QString& message, Level)
         mOutputStream.setCodec(QTextCodec::codecForName("UTF-8"));
     }
 
-    mOutputStream << message << QString("\n");
+    mOutputStream << message << QLatin1Char('\n');
+}
+
+void QsLogging::FileDestination::flush()
+{
     mOutputStream.flush();
 }
 
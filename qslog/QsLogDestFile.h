@@ -99,6 +99,7 @@ public:
     virtual void write(const QString& message, Level level);
     virtual bool isValid();
     virtual QString type() const;
+    virtual void flush();
 
 private:
     QFile mFile;